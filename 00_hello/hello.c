@@ -16,20 +16,14 @@
  */
 #include <mcs51/8051.h>
 
-static void delay(unsigned int t);
+#include "delay.h"
 
 void main(void) {
   for(;;) {
     // Toggle LED at P2_0
     P2_0 = 0;
-    delay(30000);
+    delay_ms(250);
     P2_0 = 1;
-    delay(30000);
+    delay_ms(250);
   }
 }
-
-static void delay(unsigned int t) {
-  while (t--)
-    ;
-}
-
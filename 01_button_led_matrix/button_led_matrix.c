@@ -15,12 +15,13 @@
  * @author Thomas Reidemeister
  */
 #include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
 #include <stdint.h>
 
-#define SRCLK P3_6
-#define RCLK  P3_5
-#define SER   P3_4
+#include "keypad.h"
+#include "matrix.h"
+#include "timer.h"
+
+#define ROW_US 1000 // 1ms per row, 125Hz per frame, also the keypad scan tick
 
 // character rom for 8x8 matrix display
 const uint8_t matrix_chars[] = {
@@ -185,93 +186,38 @@ const uint8_t matrix_chars[] = {
   0b00000000, // ........
 };
 
-void HC575_write(uint8_t value) {
-  SRCLK=0;
-  RCLK=0;
+void display_digit(int8_t digit) {
   for(uint8_t i=0; i<8; i++) {
-    SER = value >> 7;
-    value <<= 1;
-    SRCLK = 1;
-    NOP();
-    NOP();
-    SRCLK = 0;
-  }
-  RCLK = 1;
-  NOP();
-  NOP();
-  RCLK = 0;
-}
-
-#define GPIO_KEYPAD P1
-
-int8_t key_value;
-
-void scan_keypad(void) {
-  GPIO_KEYPAD = 0x0F; // Enable P10..P13 (all rows) to see if any key is pressed
-  NOP(); NOP();
-  key_value = -1; // Assume no key pressed
-  if(GPIO_KEYPAD != 0x0F) { // A key is pressed, shorted to ground
-    switch (GPIO_KEYPAD) {
-      case 0x07: // Column 0
-        key_value = 0;
-        break;
-      case 0x0B: // Column 1
-        key_value = 1;
-        break;
-      case 0x0D: // Column 2
-        key_value = 2;
-        break;
-      case 0x0E: // Column 3
-        key_value = 3;
-        break;
-    }
-    NOP();
-    NOP();
-    // Enable all columns and find the row
-    GPIO_KEYPAD = 0xF0;
-    NOP();
-    NOP();
-    if (key_value != -1) {
-      switch (GPIO_KEYPAD) {
-        case 0x70: // Row 0
-          key_value += 0;
-          break;
-        case 0xB0: // Row 1
-          key_value += 4;
-          break;
-        case 0xD0: // Row 2
-          key_value += 8;
-          break;
-        case 0xE0: // Row 3
-          key_value += 12;
-          break;
-      }
-    }
+    // Blank for invalid digits (no key pressed)
+    matrix_back()[i] = (digit > 0x0F || digit < 0) ? 0x00 : matrix_chars[i+(digit*8)];
   }
-  GPIO_KEYPAD = 0x00; // Disable all rows and columns
-  NOP(); NOP();
+  matrix_swap();
 }
 
-void display_digit(int8_t digit) {
-  if(digit > 0x0F || digit < 0) return; // Invalid digit
-  P0 = 0xFF;
-  // Shift a single '1' through the 74HC595 to light up LEDs one by one
-  for(uint8_t i=0; i<8; i++) {
-    P0 = ~matrix_chars[i+(digit*8)];
-    uint8_t scan_line = 7-i; // Scan from top to bottom
-    HC575_write((1 << scan_line)); // invert since active low
-    HC575_write(0); // invert since active low, to avoid ghosting
-//    for(uint16_t j=0; j<30000; j++); // Simple delay (reduce for perceptible zero)
-  }
+void tf0_isr(void) __interrupt(TF0_VECTOR) {
+  matrix_scan();
+  keypad_scan();
+  TIMER0_RELOAD_US(ROW_US);
+  TF0 = 0;
 }
 
 void main(void) {
+  timer0_init_us(ROW_US);
+
+  ET0 = 1; /* Enable Timer 0 interrupt */
+  EA  = 1; /* Enable global interrupts */
+
+  uint8_t held = 0;
+  display_digit(-1);
   for(;;) {
-    scan_keypad();
-    if(key_value >= 0) {
-      display_digit(key_value);
-    } else {
-      HC575_write(0); // Turn off all rows
+    uint8_t event = keypad_get(); // Refresh and scanning run from the interrupt, only redraw on events
+    if(event == KEYPAD_NONE)
+      continue;
+    if(!(event & KEYPAD_RELEASE)) {
+      held++;
+      display_digit(event); // Show the last pressed key
+    } else if(held && --held == 0) { // A press dropped from a full queue must not wrap the count
+      display_digit(-1);    // Blank once all keys are released
     }
   }
 }
\ No newline at end of file
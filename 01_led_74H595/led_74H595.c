@@ -15,29 +15,10 @@
  * @author Thomas Reidemeister
  */
 #include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
 #include <stdint.h>
 
-#define SRCLK P3_6
-#define RCLK  P3_5
-#define SER   P3_4
-
-void HC575_write(uint8_t value) {
-  SRCLK=0;
-  RCLK=0;
-  for(uint8_t i=0; i<8; i++) {
-    SER = value >> 7;
-    value <<= 1;
-    SRCLK = 1;
-    NOP();
-    NOP();
-    SRCLK = 0;
-  }
-  RCLK = 1;
-  NOP();
-  NOP();
-  RCLK = 0;
-}
+#include "delay.h"
+#include "hc595.h"
 
 void main(void) {
   for(;;) {
@@ -45,7 +26,7 @@ void main(void) {
     // Shift a single '1' through the 74HC595 to light up LEDs one by one
     for(uint8_t i=0; i<8; i++) {
       HC575_write(~(1 << i)); // invert since active low
-      for(uint16_t j=0; j<30000; j++); // Simple delay
+      delay_ms(250);
     }
   }
 }
\ No newline at end of file
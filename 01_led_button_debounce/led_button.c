@@ -14,81 +14,44 @@
  * @file led_button.c Button debouncing with a timer.
  * @author Thomas Reidemeister
  */
-#include <mcs51/8051.h>
+#include <mcs51/8052.h>
+#include <stdint.h>
 
-void timer0_init(void) {
-  TMOD &= 0xF0;	/* Clear Timer 0 mode bits */
-  TMOD |= 0x1;	/* Set Timer 0 mode to 16-bit */
-  TH0 = 0x3c;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0xb0;	/* Set Timer 0 low byte for 16-bit mode */
-  TF0 = 0;	/* Clear Timer 0 overflow flag */
-  TR0 = 1;	/* Start Timer 0 */
-}
+#include "debounce.h"
+#include "power.h"
+#include "sched.h"
+#include "timebase.h"
 
-void main(void) {
-  timer0_init();
+uint8_t led_state = 0;
 
-  ET0 = 1;	/* Enable Timer 0 interrupt */
-  EA  = 1; /* Enable global interrupts */
-
-  for(;;);
+void tf2_isr(void) __interrupt(TF2_VECTOR) {
+  TF2 = 0;	/* Clear Timer 2 overflow flag, not done by hardware */
+  timebase_tick();
 }
 
-__bit led_0_state = 0;
-unsigned char button_0_counter = 0;
-__bit led_1_state = 0;
-unsigned char button_1_counter = 0;
-__bit led_2_state = 0;
-unsigned char button_2_counter = 0;
-__bit led_3_state = 0;
-unsigned char button_3_counter = 0;
+// Runs every 10ms
+static void buttons(void) {
+    // Buttons 0..3 on P3_1, P3_0, P3_2, P3_3 (active low), debounced all at once
+    debounce_update(~P3 & 0x0F);
 
-void tf0_isr(void) __interrupt(TF0_VECTOR) {
-    // Adance counters if started hysteresis
-    if(button_0_counter) {
-      button_0_counter++;
-      if(button_0_counter >= 20)
-        button_0_counter = 0; // Reset counter after hysteresis period
-    }
-    if(button_1_counter) {
-      button_1_counter++;
-      if (button_1_counter >= 20)
-        button_1_counter = 0; // Reset counter after hysteresis period
-    }
-    if(button_2_counter) {
-      button_2_counter++;
-      if (button_2_counter >= 20)
-        button_2_counter = 0; // Reset counter after hysteresis period
-    }
-    if(button_3_counter) {
-      button_3_counter++;
-      if (button_3_counter >= 20)
-        button_3_counter = 0; // Reset counter after hysteresis period
-    }
+    led_state ^= debounce_pressed; // Toggle LED on every valid press
+    led_state &= ~debounce_long;   // Holding a button for 1s turns its LED off
 
-    // Button 0
-    if(P3_1 == 0 && button_0_counter == 0) {
-      led_0_state = !led_0_state;
-      button_0_counter++; // Reset counter after valid press
-    }
-    if(P3_0 == 0 && button_1_counter == 0) {
-      led_1_state = !led_1_state;
-      button_1_counter++; // Reset counter after valid press
-    }
-    if(P3_2 == 0 && button_2_counter == 0) {
-      led_2_state = !led_2_state;
-      button_2_counter++; // Reset counter after valid press
-    }
-    if(P3_3 == 0 && button_3_counter == 0) {
-      led_3_state = !led_3_state;
-      button_3_counter++; // Reset counter after valid press
-    }
+    P2_0 = (led_state >> 1) & 1; // Button 0 is P3_1
+    P2_1 = led_state & 1;        // Button 1 is P3_0
+    P2_2 = (led_state >> 2) & 1;
+    P2_3 = (led_state >> 3) & 1;
+}
 
-    P2_0 = led_0_state;
-    P2_1 = led_1_state;
-    P2_2 = led_2_state;
-    P2_3 = led_3_state;
+void main(void) {
+  sched_init(); // 1ms system tick on Timer 2
+  sched_every(buttons, SCHED_MS(10));
 
-    TF0 = 0;	/* Clear Timer 0 overflow flag */
-}
+  ET2 = 1;	/* Enable Timer 2 interrupt */
+  EA  = 1; /* Enable global interrupts */
 
+  for(;;) {
+    if(!sched_run())
+      power_idle(); // Sleep until the next tick, no power-down since K1/K2 (P3_1/P3_0) cannot wake the CPU
+  }
+}
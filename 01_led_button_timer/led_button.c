@@ -14,32 +14,24 @@
  * @file led_button.c Button sampling with timer.
  * @author Thomas Reidemeister
  */
-#include <mcs51/8051.h>
-
-void timer0_init(void) {
-  TMOD &= 0xF0;	/* Clear Timer 0 mode bits */
-  TMOD |= 0x1;	/* Set Timer 0 mode to 16-bit */
-  TH0 = 0x3c;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0xb0;	/* Set Timer 0 low byte for 16-bit mode */
-  TF0 = 0;	/* Clear Timer 0 overflow flag */
-  TR0 = 1;	/* Start Timer 0 */
-}
-
-void main(void) {
-  timer0_init();
+#include <mcs51/8052.h>
 
-  ET0 = 1;	/* Enable Timer 0 interrupt */
-  EA  = 1; /* Enable global interrupts */
-
-  for(;;);
-}
+#include "power.h"
+#include "sched.h"
+#include "timebase.h"
 
 __bit led_0_state = 0;
 __bit led_1_state = 0;
 __bit led_2_state = 0;
 __bit led_3_state = 0;
 
-void tf0_isr(void) __interrupt(TF0_VECTOR) {
+void tf2_isr(void) __interrupt(TF2_VECTOR) {
+  TF2 = 0;	/* Clear Timer 2 overflow flag, not done by hardware */
+  timebase_tick();
+}
+
+// Runs every 50ms
+static void buttons(void) {
     if(P3_1 == 0) {
       led_0_state = !led_0_state;
     }
@@ -57,6 +49,17 @@ void tf0_isr(void) __interrupt(TF0_VECTOR) {
     P2_1 = led_1_state;
     P2_2 = led_2_state;
     P2_3 = led_3_state;
+}
+
+void main(void) {
+  sched_init(); // 1ms system tick on Timer 2
+  sched_every(buttons, SCHED_MS(50));
 
-    TF0 = 0;	/* Clear Timer 0 overflow flag */
-}
\ No newline at end of file
+  ET2 = 1;	/* Enable Timer 2 interrupt */
+  EA  = 1; /* Enable global interrupts */
+
+  for(;;) {
+    if(!sched_run())
+      power_idle(); // Sleep until the next tick
+  }
+}
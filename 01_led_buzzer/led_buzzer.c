@@ -14,41 +14,69 @@
  * @file led_buzzer.c LED and Buzzer interfacing.
  * @author Thomas Reidemeister
  */
-#include <mcs51/8051.h>
-
-void timer0_init(void) {
-  TMOD &= 0xF0;	/* Clear Timer 0 mode bits */
-  TMOD |= 0x1;	/* Set Timer 0 mode to 16-bit */
-  TH0 = 0xFC;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0x18;	/* Set Timer 0 low byte for 16-bit mode */
-  TF0 = 0;	/* Clear Timer 0 overflow flag */
-  TR0 = 1;	/* Start Timer 0 */
-}
+#include <mcs51/8052.h>
 
-void main(void) {
-  timer0_init();
+#include "debounce.h"
+#include "power.h"
+#include "sched.h"
+#include "timebase.h"
 
-  ET0 = 1;	/* Enable Timer 0 interrupt */
-  EA  = 1; /* Enable global interrupts */
+#define SLEEP_AFTER 1000 // Ticks without a button held before powering down (1s)
+
+__bit buzzer_state = 0;
+static uint16_t quiet = 0;
+static __bit sleepy = 0;
 
-  for(;;);
+// Wake-up from power-down only, the buttons are on INT0/INT1
+void int0_isr(void) __interrupt(IE0_VECTOR) {
 }
 
-__bit buzzer_state = 0;
+void int1_isr(void) __interrupt(IE1_VECTOR) {
+}
+
+void tf2_isr(void) __interrupt(TF2_VECTOR) {
+  TF2 = 0;	/* Clear Timer 2 overflow flag, not done by hardware */
+  timebase_tick();
+}
 
-void tf0_isr(void) __interrupt(TF0_VECTOR) {
-  // Mirror button 0 state to LED 0 and buzzer at P1_5
-  P2_0 = P3_2; // LED 0 mirrors button 0
+// Runs every tick (1ms)
+static void buttons(void) {
+  debounce_update(~P3 & 0x0C); // Buttons 0 and 3 on P3_2 and P3_3 (active low)
 
-  // Toggle buzzer state when button 3 is pressed
-  if(P3_3 == 0) {
+  // Mirror debounced button 0 state to LED 0
+  P2_0 = !(debounce_state & 0x04); // LED 0 mirrors button 0
+
+  // Toggle buzzer at P1_5 every tick (500Hz tone) while button 3 is held
+  if(debounce_state & 0x08) {
     buzzer_state = !buzzer_state;
+  } else {
+    buzzer_state = 0; // Silent level, also while powered down
   }
   P1_5 = buzzer_state;
 
-  // Reload Timer 0 for next interrupt
-  TH0 = 0xFC;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0x18;	/* Set Timer 0 low byte for 16-bit mode */
-  TF0 = 0;	/* Clear Timer 0 overflow flag */
+  if(debounce_state) {
+    quiet = 0;
+  } else if(++quiet >= SLEEP_AFTER) {
+    quiet = 0;
+    sleepy = 1;
+  }
 }
 
+void main(void) {
+  sched_init(); // 1ms system tick on Timer 2
+  sched_every(buttons, SCHED_MS(1));
+
+  ET2 = 1;	/* Enable Timer 2 interrupt */
+  EA  = 1; /* Enable global interrupts */
+
+  for(;;) {
+    if(sched_run())
+      continue;
+    if(sleepy) {
+      sleepy = 0;
+      power_down(POWER_WAKE_INT0 | POWER_WAKE_INT1);
+    } else {
+      power_idle(); // Sleep until the next tick
+    }
+  }
+}
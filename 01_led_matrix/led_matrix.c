@@ -15,12 +15,13 @@
  * @author Thomas Reidemeister
  */
 #include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
 #include <stdint.h>
 
-#define SRCLK P3_6
-#define RCLK  P3_5
-#define SER   P3_4
+#include "delay.h"
+#include "matrix.h"
+#include "timer.h"
+
+#define ROW_US 1000 // 1ms per row, 125Hz per frame
 
 // draw a zero
 uint8_t matrix_rows[] = {
@@ -34,33 +35,25 @@ uint8_t matrix_rows[] = {
   0b00011100, // ...###..
 };
 
-void HC575_write(uint8_t value) {
-  SRCLK=0;
-  RCLK=0;
-  for(uint8_t i=0; i<8; i++) {
-    SER = value >> 7;
-    value <<= 1;
-    SRCLK = 1;
-    NOP();
-    NOP();
-    SRCLK = 0;
-  }
-  RCLK = 1;
-  NOP();
-  NOP();
-  RCLK = 0;
+void tf0_isr(void) __interrupt(TF0_VECTOR) {
+  matrix_scan();
+  TIMER0_RELOAD_US(ROW_US);
+  TF0 = 0;
 }
 
 void main(void) {
-  for(;;) {
-    P0 = 0xFF;
-    // Shift a single '1' through the 74HC595 to light up LEDs one by one
-    for(uint8_t i=0; i<8; i++) {
-      P0 = ~matrix_rows[i];
-      uint8_t scan_line = 7-i; // Scan from top to bottom
-      HC575_write((1 << scan_line)); // invert since active low
-      HC575_write(0); // invert since active low, to avoid ghosting
-      for(uint16_t j=0; j<30000; j++); // Simple delay (reduce for perceptible zero)
+  timer0_init_us(ROW_US);
+
+  ET0 = 1; /* Enable Timer 0 interrupt */
+  EA  = 1; /* Enable global interrupts */
+
+  for(uint8_t shift = 0;; shift = (shift + 1) & 0x07) {
+    // Draw the zero rotated by shift columns into the back buffer, the refresh keeps running meanwhile
+    for(uint8_t i=0; i<MATRIX_ROWS; i++) {
+      uint8_t row = matrix_rows[i];
+      matrix_back()[i] = (row >> shift) | (row << (8 - shift));
     }
+    matrix_swap();
+    delay_ms(250);
   }
 }
\ No newline at end of file
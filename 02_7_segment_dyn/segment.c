@@ -15,37 +15,10 @@
  * @author Thomas Reidemeister
  */
 #include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
 #include <stdint.h>
 
-const uint8_t segment_map[] = {
-    //dGFEDCBA
-    0b00111111, // 0
-    0b00000110, // 1
-    0b01011011, // 2
-    0b01001111, // 3
-    0b01100110, // 4
-    0b01101101, // 5
-    0b01111101, // 6
-    0b00000111, // 7
-    0b01111111, // 8
-    0b01101111, // 9
-    0b01110111, // A
-    0b01111100, // b
-    0b00111001, // C
-    0b01011110, // d
-    0b01111001, // E
-    0b01110001, // F
-};
-
-const uint8_t segment_dp = 0b10000000; // Decimal point segment
-
-#define LED_DIGIT P0
-
-void delay(uint16_t t) {
-  while (t--)
-    ;
-}
+#include "delay.h"
+#include "segment.h"
 
 void main(void) {
   P0 = 0x00; // Initialize port
@@ -55,9 +28,9 @@ void main(void) {
     // Display hex digits 0-7 with decimal point on, incrementing on each digitit
     for(uint8_t i=0; i<8; i++) {
       P2 = i<<2; // activate digit i (P2_2..P2_4)
-      LED_DIGIT = segment_map[i] | segment_dp; // Display digit with decimal point
-      delay(200); // Short delay for multiplexing
-//      delay(60000); // Long delay to make multiplexing visible
+      LED_DIGIT = segment_map[i] | SEGMENT_DP; // Display digit with decimal point
+      delay_ms(1); // Short delay for multiplexing
+//      delay_ms(500); // Long delay to make multiplexing visible
       LED_DIGIT = 0x00; // Turn off all segments
     }
   }
@@ -14,29 +14,14 @@
  * @file lcd.c 7 Segment display interfacing, dynamic switching.
  * @author Thomas Reidemeister
  */
-#include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
+#include <mcs51/8052.h>
 #include <stdint.h>
 
-#define HD44780_E  P2_7
-#define HD44780_RS P2_6
-#define HD44780_RW P2_5
-#define HD44780_DATA P0
-
-#define HD44780_FUNC_SET        0x30
-#define HD44780_DISP_CLEAR      0x01
-#define HD44780_DISP_OFF        0x08
-#define HD44780_DISP_ON         0x0C
-#define HD44780_CURSOR_ON       0x0E
-#define HD44780_CURSOR_OFF      0x0C
-#define HD44780_CURSOR_BLINK    0x0F
-#define HD44780_RETURN_HOME     0x02
-#define HD44780_ENTRY_MODE      0x06
-#define HD44780_2_ROWS          0x08
-#define HD44780_POSITION        0x80
-#define HD44780_ROW2_START      0x40
-#define HD44780_CGRAM_ADDR      0x40
-#define HD44780_DRAM_ADDR       0x80
+#include "hd44780.h"
+#include "hd44780_con.h"
+#include "power.h"
+#include "sched.h"
+#include "timebase.h"
 
 const uint8_t custom_char_heart[] = {
   0b00000,
@@ -49,76 +34,46 @@ const uint8_t custom_char_heart[] = {
   0b00000
 };
 
-void delay(uint16_t t) {
-  while (t--) // Simple delay loop (more than 1us at 12MHz)
-    ;
-}
-
-void hd44780_byte(uint8_t d) {
-  HD44780_E = 1;
-  HD44780_DATA = d;
-  delay(10); // Enable pulse width
-  HD44780_E = 0;
-  delay(10); // Data hold time
-}
-
-void hd44780_command(uint8_t cmd) {
-  HD44780_RS = 0; // Command mode
-  HD44780_RW = 0; // Write mode
-  hd44780_byte(cmd);
-  delay(100); // Wait for command to process
-}
-
-void hd44780_data(uint8_t data) {
-  HD44780_RS = 1; // Data mode
-  HD44780_RW = 0; // Write mode
-  hd44780_byte(data);
-  delay(100); // Wait for data to process
-}
-
-void hd44780_text(const char* str) {
-  while (*str) {
-    hd44780_data((uint8_t)(*str));
-    str++;
-  }
-}
-
-void hd44780_init() { // Figure 23 from HD44780 datasheet
-  delay(15000); // Wait for more than 15ms after Vcc rises to 4.5V
-
-  hd44780_command(HD44780_FUNC_SET);
-  delay(5000); // Wait for more than 4.1ms
-  hd44780_command(HD44780_FUNC_SET);
-  delay(1000); // Wait for more than 1ms
-  hd44780_command(HD44780_FUNC_SET);
-  delay(100); // Wait for more than 100us
-
-  hd44780_command(HD44780_FUNC_SET | HD44780_2_ROWS);
-  hd44780_command(HD44780_DISP_OFF);
-  hd44780_command(HD44780_DISP_CLEAR);
-  hd44780_command(HD44780_ENTRY_MODE);
+void tf2_isr(void) __interrupt(TF2_VECTOR) {
+  TF2 = 0;	/* Clear Timer 2 overflow flag, not done by hardware */
+  timebase_tick();
 }
 
-void hd44780_custom_char(uint8_t location, const uint8_t* charmap) {
-  location &= 0x7; // We only have 8 locations 0-7
-  hd44780_command(HD44780_CGRAM_ADDR | (location << 3)); // each location takes 8 bytes
-  for (uint8_t i = 0; i < 8; i++) {
-    hd44780_data(charmap[i]);
-  }
-  // Return to DDRAM
-  hd44780_command(HD44780_DRAM_ADDR);
+static uint16_t seconds = 0;
+
+// Runs every second
+static void clock(void) {
+  uint8_t idle = power_idle_percent();
+  if(++seconds > 999)
+    seconds = 0;
+  hd44780_con_goto(0, 13);
+  hd44780_con_printf("%2u%%", idle > 99 ? 99 : idle); // Share of the last second the CPU was idle
+  hd44780_con_goto(1, 13);
+  hd44780_con_printf("%3u", seconds);
+  hd44780_con_flush(); // Only the changed digits go to the display
 }
 
 void main(void) {
   hd44780_init();
   hd44780_custom_char(0, custom_char_heart);
   hd44780_command(HD44780_DISP_ON);
-  hd44780_text("Hello, World!");
-  hd44780_command((HD44780_POSITION | HD44780_ROW2_START) | 1);
-  hd44780_data('\x00'); // Custom heart character
-  hd44780_text("From 8051!");
-  hd44780_data('\x00'); // Custom heart character
+  hd44780_con_clear();
+  hd44780_con_invalidate(); // Display content after init is not known to the console
+  hd44780_con_puts("Hello, World!");
+  hd44780_con_goto(1, 1);
+  hd44780_con_putc('\x00'); // Custom heart character
+  hd44780_con_puts("From 8051!");
+  hd44780_con_putc('\x00'); // Custom heart character
+  hd44780_con_flush();
+
+  sched_init(); // 1ms system tick on Timer 2
+  sched_every(clock, SCHED_MS(1000));
+  ET2 = 1;	/* Enable Timer 2 interrupt */
+  EA  = 1; /* Enable global interrupts */
+
   for(;;) {
+    if(!sched_run())
+      power_idle(); // Sleep until the next tick
   }
 }
 
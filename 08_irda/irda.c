@@ -14,118 +14,74 @@
  * @file i2c.c Example for bitbang I2C communication with AT24C02 EEPROM.
  * @author Thomas Reidemeister
  */
-#include <mcs51/8051.h>
-#include <mcs51/compiler.h> // NOP
+#include <mcs51/8052.h>
 #include <stdint.h>
 
-#define IRDA_RX P3_2
+#include "nec.h"
+#include "power.h"
+#include "segment.h"
+#include "timebase.h"
+#include "uart.h"
 
-// Use timer and ext tool https://reidemeister.com/tools
-void timer0_init(void) {
-  TMOD &= 0xF0;	/* Clear Timer 0 mode bits */
-  TMOD |= 0x1;	/* Set Timer 0 mode to 16-bit */
-  TH0 = 0xfc;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0x18;	/* Set Timer 0 low byte for 16-bit mode */
-  TF0 = 0;	/* Clear Timer 0 overflow flag */
-  TR0 = 1;	/* Start Timer 0 */
+#define FRAME_NEC   0x01  // Payload: address (little endian), command, repeat count
+#define SLEEP_AFTER 10000 // ms without a frame before powering down
 
-  // Also enable interrupt
-  ET0 = 1;
+void int0_isr(void) __interrupt(IE0_VECTOR) {
+  nec_edge();
 }
 
-void ext_init(void) {
-  IT0 = 1;	/* INT0 (P3.2) Falling Edge */
-  EX0 = 1;	/* Enable INT0 (P3.2) */
+// Timer 0 runs free for the edge timing, the display is multiplexed from the 1ms timebase tick. There is no
+// interrupt part way through the tick, so the display stays at full brightness.
+void tf2_isr(void) __interrupt(TF2_VECTOR) {
+  TF2 = 0;	/* Clear Timer 2 overflow flag, not done by hardware */
+  timebase_tick();
+  segment_scan();
 }
 
-uint8_t ms_counter = 0;
-int8_t pulse_count = 0;
-uint32_t pattern = 0;
-uint32_t last_pattern = 0xFFFFFFFF;
-
-void tf0_isr(void) __interrupt(TF0_VECTOR) {
-  P3_4 = !P3_4; // Heartbeat on P3.3
-  // Reload Timer 0 for next interrupt
-  TH0 = 0xfc;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0x18;	/* Set Timer 0 low byte for 16-bit mode */
-  if(ms_counter<50) {
-    ms_counter++;
-  }
+void si0_isr(void) __interrupt(SI0_VECTOR) {
+  uart_tx_next();
 }
 
-void int0_isr(void) __interrupt(IE0_VECTOR) {
-  uint8_t cur_timer = ms_counter;
-
-  // Reset for next pulse (including resetting timer)
-  ms_counter = 0;
-  TH0 = 0xfc;	/* Set Timer 0 high byte for 16-bit mode */
-  TL0 = 0x18;	/* Set Timer 0 low byte for 16-bit mode */
-
-  pulse_count++;
-
-  if(cur_timer == 50) {
-    // Timeout occurred, assume sync pulse
-    pulse_count = -2; // Ignore sync edges
-    pattern = 0;      // Reset pattern
-  } else if(pulse_count >= 0 && pulse_count < 31) {
-    // Record bits after sync
-    if(cur_timer>= 2) { // Threshold between 0 and 1
-      pattern |= 0x00000001 << (31 - pulse_count); // MSB first
-    }
-  }
-  if(pulse_count >= 32) {
-    // Ignore extra pulses
-    last_pattern = pattern;
-  }
-}
-
-const uint8_t segment_map[] = {
-    //dGFEDCBA
-    0b00111111, // 0
-    0b00000110, // 1
-    0b01011011, // 2
-    0b01001111, // 3
-    0b01100110, // 4
-    0b01101101, // 5
-    0b01111101, // 6
-    0b00000111, // 7
-    0b01111111, // 8
-    0b01101111, // 9
-    0b01110111, // A
-    0b01111100, // b
-    0b00111001, // C
-    0b01011110, // d
-    0b01111001, // E
-    0b01110001, // F
-};
-
-#define LED_DIGIT P0
-
-void delay(uint16_t t) {
-  while (t--)
-    ;
+// Display dark and the last frame sent, then sleep until the receiver pulls INT0 low
+static void sleep(void) {
+  ET2 = 0; // Stop the refresh
+  LED_DIGIT = SEGMENT_BLANK;
+  power_down(POWER_WAKE_INT0); // INT0 is armed by nec_init() anyway, the waking edge goes to nec_edge()
+  ET2 = 1;
 }
 
 void main(void) {
-  timer0_init();
-  ext_init();
+  nec_init(); // Timer 0 free-running for edge timing, INT0 on falling edges
+  PX0 = 1; // Edges preempt the display refresh, keeps the pulse timing exact
+  for(uint8_t i=0; i<SEGMENT_DIGITS; i++) {
+    segment_digits[i] = segment_map[0];
+  }
+  timebase_init();
+  uart_init(); // Timer 1 generates the baud rate
+  ET2 = 1; // Enable Timer 2 interrupt
+  ES = 1; // Enable serial interrupt
   EA = 1; // Enable global interrupts
 
-  P0 = 0x00; // Initialize port
-  P2 = 0x00;
-
+  uint32_t last = 0; // Time of the last frame
   for(;;) {
-    // Display hex digits 0-7 with decimal point on, incrementing on each digit
-    for(uint8_t i=0; i<8; i++) {
-      P2 = i<<2; // activate digit i (P2_2..P2_4)
-
-      // Figure out the corresponding nibble in the 32-bit code
-      uint8_t nibble = (last_pattern >> i*4) & 0x0F;
-      LED_DIGIT = segment_map[nibble];
-      delay(200); // Short delay for multiplexing
-      LED_DIGIT = 0x00; // Turn off all segments
+    struct nec_frame frame;
+    if(!nec_get(&frame)) {
+      if(timebase_ms() - last >= SLEEP_AFTER && uart_tx_idle) {
+        sleep();
+        last = timebase_ms(); // The timebase stood still while powered down
+      } else {
+        power_idle(); // Every edge and display tick wakes the CPU again
+      }
+    } else {
+      last = timebase_ms();
+      // Show address (digits 7..4), command (digits 3..2) and repeat count (digits 1..0) in hex
+      uint32_t code = ((uint32_t)frame.address << 16) | ((uint16_t)frame.command << 8) | frame.repeat;
+      for(uint8_t i=0; i<SEGMENT_DIGITS; i++) {
+        segment_digits[i] = segment_map[(code >> i*4) & 0x0F];
+      }
+      segment_blink = frame.repeat ? 0x03 : 0x00; // Repeat count blinks while the key is held
+      uint8_t payload[4] = {(uint8_t)frame.address, (uint8_t)(frame.address >> 8), frame.command, frame.repeat};
+      uart_frame(FRAME_NEC, payload, sizeof(payload));
     }
   }
 }
-
-
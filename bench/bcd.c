@@ -0,0 +1,35 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file bcd.c Benchmark of the decimal conversions for the 7-segment display.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "segment.h"
+
+// Spread over the digit counts, the division based int_to_digits() grows with every digit
+static const int16_t values[] = {0, 7, -42, 255, 1234, -9999, 32767, -32768};
+
+void main(void) {
+  for(;;) {
+    for(uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+      int_to_digits(values[i], segment_bcd_buf);
+      segment_s16(values[i], 0);
+      bcd_u16(values[i], segment_bcd_buf);
+      segment_u8(values[i], 0);
+      segment_s32((int32_t)values[i] * 1000, 3);
+    }
+  }
+}
@@ -0,0 +1,51 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file delay.c Benchmark of delay_us() on each code path of delay_cycles().
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+
+#include "bench.h"
+#include "delay.h"
+
+/*
+ * At 12MHz 12T one microsecond is one cycle: 1 and 7 are NOPs, 8 and 516 the ends of delay_loop8(), 517 the
+ * shortest delay_loop16() and 1000/20000 longer waits. The expected counts are checked by the bench_delay test in
+ * meson.build, keep both lists in sync.
+ */
+void main(void) {
+  for(;;) {
+    BENCH_BEGIN(us_1);
+    delay_us(1);
+    BENCH_END(us_1);
+    BENCH_BEGIN(us_7);
+    delay_us(7);
+    BENCH_END(us_7);
+    BENCH_BEGIN(us_8);
+    delay_us(8);
+    BENCH_END(us_8);
+    BENCH_BEGIN(us_516);
+    delay_us(516);
+    BENCH_END(us_516);
+    BENCH_BEGIN(us_517);
+    delay_us(517);
+    BENCH_END(us_517);
+    BENCH_BEGIN(us_1000);
+    delay_us(1000);
+    BENCH_END(us_1000);
+    BENCH_BEGIN(us_20000);
+    delay_us(20000);
+    BENCH_END(us_20000);
+  }
+}
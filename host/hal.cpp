@@ -0,0 +1,130 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hal.cpp Host build of the lib/ drivers against the simulated port model.
+ * @author Thomas Reidemeister
+ */
+// The drivers are plain C, they are compiled as C++ here so that SFR accesses resolve to the port
+// model in host/mcs51/8051.h. The delay loops are provided by sim.cpp.
+#include "delay/delay_ms.c"
+#include "timer/timer0_init.c"
+#include "timer/timer1_init.c"
+#include "timebase/timebase.c"
+#include "timebase/timebase_init.c"
+#include "timebase/timebase_tick.c"
+#include "timebase/timebase_clock.c"
+#include "timebase/timebase_since.c"
+#include "timebase/timebase_ms.c"
+#include "timebase/timebase_us.c"
+#include "sched/sched.c"
+#include "sched/sched_init.c"
+#include "sched/sched_now.c"
+#include "sched/sched_add.c"
+#include "sched/sched_cancel.c"
+#include "sched/sched_run.c"
+#include "power/power_idle.c"
+#include "power/power_idle_percent.c"
+#include "power/power_down.c"
+#include "segment/segment_map.c"
+#include "segment/segment_scan.c"
+#include "segment/segment_brightness.c"
+#include "segment/int_to_digits.c"
+#include "segment/segment_bcd.c"
+#include "segment/segment_u8.c"
+#include "segment/segment_s8.c"
+#include "segment/segment_u16.c"
+#include "segment/segment_s16.c"
+#include "segment/segment_u32.c"
+#include "segment/segment_s32.c"
+#include "bcd/bcd_u8.c"
+#include "bcd/bcd_u16.c"
+#include "bcd/bcd_u32.c"
+#include "hc595/hc575_write.c"
+#include "matrix/matrix_scan.c"
+#include "matrix/matrix_swap.c"
+#include "keypad/keypad_scan.c"
+#include "keypad/keypad_get.c"
+#include "debounce/debounce_update.c"
+#include "nec/nec_init.c"
+#include "nec/nec_edge.c"
+#include "nec/nec_get.c"
+#include "hd44780/hd44780_strobe.c"
+#include "hd44780/hd44780_byte.c"
+#include "hd44780/hd44780_wait.c"
+#include "hd44780/hd44780_command.c"
+#include "hd44780/hd44780_data.c"
+#include "hd44780/hd44780_text.c"
+#include "hd44780/hd44780_init.c"
+#include "hd44780/hd44780_custom_char.c"
+#include "hd44780_con/hd44780_con.c"
+#include "hd44780_con/hd44780_con_invalidate.c"
+#include "hd44780_con/hd44780_con_clear.c"
+#include "hd44780_con/hd44780_con_putc.c"
+#include "hd44780_con/hd44780_con_puts.c"
+#include "hd44780_con/hd44780_con_printf.c"
+#include "hd44780_con/hd44780_con_flush.c"
+#include "st7920/st7920_byte.c"
+#include "st7920/st7920_command.c"
+#include "st7920/st7920_data.c"
+#include "st7920/st7920_begin_data.c"
+#include "st7920/st7920_stream.c"
+#include "st7920/st7920_end.c"
+#include "st7920/st7920_text.c"
+#include "st7920/st7920_pos.c"
+#include "st7920/st7920_init.c"
+#include "st7920_fb/st7920_fb.c"
+#include "st7920_fb/st7920_fb_band.c"
+#include "st7920_fb/st7920_fb_invalidate.c"
+#include "st7920_fb/st7920_fb_validate.c"
+#include "st7920_fb/st7920_fb_fill.c"
+#include "st7920_fb/st7920_fb_pixel.c"
+#include "st7920_fb/st7920_fb_word.c"
+#include "st7920_fb/st7920_fb_blit.c"
+#include "st7920_fb/st7920_fb_flush.c"
+#include "wire/wire_init.c"
+#include "wire/wire_write_byte.c"
+#include "wire/wire_read_byte.c"
+#include "wire/wire_write_bit.c"
+#include "wire/wire_read_bit.c"
+#include "wire/wire_select.c"
+#include "wire/wire_search.c"
+#include "wire/wire_crc8.c"
+#include "ds18b20/ds18b20_start_conversion.c"
+#include "ds18b20/ds18b20_read_temperature.c"
+#include "ds18b20/ds18b20_scan.c"
+#include "ds18b20/ds18b20_read.c"
+#include "ds18b20/ds18b20_start.c"
+#include "ds18b20/ds18b20_poll.c"
+#include "ds18b20/ds18b20_tick.c"
+#include "ds18b20/ds18b20_set_resolution.c"
+#include "ds18b20/ds18b20_to_bcd.c"
+#include "i2c/i2c_scl_high.c"
+#include "i2c/i2c_start.c"
+#include "i2c/i2c_stop.c"
+#include "i2c/i2c_write.c"
+#include "i2c/i2c_read.c"
+#include "i2c/i2c_recover.c"
+#include "i2c/i2c_write_buf.c"
+#include "i2c/i2c_read_buf.c"
+#include "at24c02/at24c02_write_byte.c"
+#include "at24c02/at24c02_read_byte.c"
+#include "at24c02/at24c02_wait_ready.c"
+#include "at24c02/at24c02_write_page.c"
+#include "at24c02/at24c02_read_seq.c"
+#include "uart/uart.c"
+#include "uart/uart_init.c"
+#include "uart/uart_init_timer2.c"
+#include "uart/uart_tx_next.c"
+#include "uart/uart_write.c"
+#include "uart/uart_csv.c"
+#include "uart/uart_frame.c"
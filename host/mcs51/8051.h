@@ -0,0 +1,141 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file 8051.h Host stand-in for SDCC's <mcs51/8051.h> mapping SFRs onto the port model.
+ * @author Thomas Reidemeister
+ */
+#ifndef HOST_MCS51_8051_H
+#define HOST_MCS51_8051_H
+
+#ifndef __cplusplus
+#error "The host SFR model needs the drivers compiled as C++ (see host/hal.cpp)"
+#endif
+
+#include "sim.h"
+
+// SDCC storage classes and function attributes
+#define __interrupt(vector)
+#define __using(bank)
+#define __bit bool
+#define __data
+#define __idata
+#define __xdata
+#define __pdata
+#define __code
+#define __naked
+#define __reentrant
+#define __critical
+
+#define IE0_VECTOR 0 // 0x03 external interrupt 0
+#define TF0_VECTOR 1 // 0x0b timer 0
+#define IE1_VECTOR 2 // 0x13 external interrupt 1
+#define TF1_VECTOR 3 // 0x1b timer 1
+#define SI0_VECTOR 4 // 0x23 serial port 0
+
+// PCON bits
+#define IDL  0x01
+#define PD   0x02
+#define GF0  0x04
+#define GF1  0x08
+#define SMOD 0x80
+
+inline sim_sfr P0   {0x80, 0xFF, 0xFF};
+inline sim_sfr SP   {0x81, 0x07, 0xFF};
+inline sim_sfr DPL  {0x82, 0x00, 0xFF};
+inline sim_sfr DPH  {0x83, 0x00, 0xFF};
+inline sim_sfr PCON {0x87, 0x00, 0xFF};
+inline sim_sfr TCON {0x88, 0x00, 0xFF};
+inline sim_sfr TMOD {0x89, 0x00, 0xFF};
+inline sim_sfr TL0  {0x8A, 0x00, 0xFF};
+inline sim_sfr TL1  {0x8B, 0x00, 0xFF};
+inline sim_sfr TH0  {0x8C, 0x00, 0xFF};
+inline sim_sfr TH1  {0x8D, 0x00, 0xFF};
+inline sim_sfr P1   {0x90, 0xFF, 0xFF};
+inline sim_sfr SCON {0x98, 0x00, 0xFF};
+inline sim_sfr SBUF {0x99, 0x00, 0xFF};
+inline sim_sfr P2   {0xA0, 0xFF, 0xFF};
+inline sim_sfr IE   {0xA8, 0x00, 0xFF};
+inline sim_sfr P3   {0xB0, 0xFF, 0xFF};
+inline sim_sfr IP   {0xB8, 0x00, 0xFF};
+inline sim_sfr PSW  {0xD0, 0x00, 0xFF};
+inline sim_sfr ACC  {0xE0, 0x00, 0xFF};
+inline sim_sfr B    {0xF0, 0x00, 0xFF};
+
+inline sim_sbit P0_0 {P0, 0};
+inline sim_sbit P0_1 {P0, 1};
+inline sim_sbit P0_2 {P0, 2};
+inline sim_sbit P0_3 {P0, 3};
+inline sim_sbit P0_4 {P0, 4};
+inline sim_sbit P0_5 {P0, 5};
+inline sim_sbit P0_6 {P0, 6};
+inline sim_sbit P0_7 {P0, 7};
+inline sim_sbit P1_0 {P1, 0};
+inline sim_sbit P1_1 {P1, 1};
+inline sim_sbit P1_2 {P1, 2};
+inline sim_sbit P1_3 {P1, 3};
+inline sim_sbit P1_4 {P1, 4};
+inline sim_sbit P1_5 {P1, 5};
+inline sim_sbit P1_6 {P1, 6};
+inline sim_sbit P1_7 {P1, 7};
+inline sim_sbit P2_0 {P2, 0};
+inline sim_sbit P2_1 {P2, 1};
+inline sim_sbit P2_2 {P2, 2};
+inline sim_sbit P2_3 {P2, 3};
+inline sim_sbit P2_4 {P2, 4};
+inline sim_sbit P2_5 {P2, 5};
+inline sim_sbit P2_6 {P2, 6};
+inline sim_sbit P2_7 {P2, 7};
+inline sim_sbit P3_0 {P3, 0};
+inline sim_sbit P3_1 {P3, 1};
+inline sim_sbit P3_2 {P3, 2};
+inline sim_sbit P3_3 {P3, 3};
+inline sim_sbit P3_4 {P3, 4};
+inline sim_sbit P3_5 {P3, 5};
+inline sim_sbit P3_6 {P3, 6};
+inline sim_sbit P3_7 {P3, 7};
+inline sim_sbit IT0  {TCON, 0};
+inline sim_sbit IE0  {TCON, 1};
+inline sim_sbit IT1  {TCON, 2};
+inline sim_sbit IE1  {TCON, 3};
+inline sim_sbit TR0  {TCON, 4};
+inline sim_sbit TF0  {TCON, 5};
+inline sim_sbit TR1  {TCON, 6};
+inline sim_sbit TF1  {TCON, 7};
+inline sim_sbit EX0  {IE, 0};
+inline sim_sbit ET0  {IE, 1};
+inline sim_sbit EX1  {IE, 2};
+inline sim_sbit ET1  {IE, 3};
+inline sim_sbit ES   {IE, 4};
+inline sim_sbit EA   {IE, 7};
+inline sim_sbit PX0  {IP, 0};
+inline sim_sbit PT0  {IP, 1};
+inline sim_sbit PX1  {IP, 2};
+inline sim_sbit PT1  {IP, 3};
+inline sim_sbit PS   {IP, 4};
+inline sim_sbit RI   {SCON, 0};
+inline sim_sbit TI   {SCON, 1};
+inline sim_sbit RB8  {SCON, 2};
+inline sim_sbit TB8  {SCON, 3};
+inline sim_sbit REN  {SCON, 4};
+inline sim_sbit SM2  {SCON, 5};
+inline sim_sbit SM1  {SCON, 6};
+inline sim_sbit SM0  {SCON, 7};
+inline sim_sbit P    {PSW, 0};
+inline sim_sbit OV   {PSW, 2};
+inline sim_sbit RS0  {PSW, 3};
+inline sim_sbit RS1  {PSW, 4};
+inline sim_sbit F0   {PSW, 5};
+inline sim_sbit AC   {PSW, 6};
+inline sim_sbit CY   {PSW, 7};
+
+#endif // HOST_MCS51_8051_H
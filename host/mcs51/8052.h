@@ -0,0 +1,41 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file 8052.h Host stand-in for SDCC's <mcs51/8052.h>, the 8051 plus Timer 2.
+ * @author Thomas Reidemeister
+ */
+#ifndef HOST_MCS51_8052_H
+#define HOST_MCS51_8052_H
+
+#include "8051.h"
+
+#define TF2_VECTOR 5 // 0x2b timer 2
+
+inline sim_sfr T2CON  {0xC8, 0x00, 0xFF};
+inline sim_sfr RCAP2L {0xCA, 0x00, 0xFF};
+inline sim_sfr RCAP2H {0xCB, 0x00, 0xFF};
+inline sim_sfr TL2    {0xCC, 0x00, 0xFF};
+inline sim_sfr TH2    {0xCD, 0x00, 0xFF};
+
+inline sim_sbit CP_RL2 {T2CON, 0};
+inline sim_sbit C_T2   {T2CON, 1};
+inline sim_sbit TR2    {T2CON, 2};
+inline sim_sbit EXEN2  {T2CON, 3};
+inline sim_sbit TCLK   {T2CON, 4};
+inline sim_sbit RCLK   {T2CON, 5};
+inline sim_sbit EXF2   {T2CON, 6};
+inline sim_sbit TF2    {T2CON, 7};
+inline sim_sbit ET2    {IE, 5};
+inline sim_sbit PT2    {IP, 5};
+
+#endif // HOST_MCS51_8052_H
@@ -0,0 +1,24 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file compiler.h Host stand-in for SDCC's <mcs51/compiler.h>.
+ * @author Thomas Reidemeister
+ */
+#ifndef HOST_MCS51_COMPILER_H
+#define HOST_MCS51_COMPILER_H
+
+#include "sim.h"
+
+#define NOP() sim_advance(1)
+
+#endif // HOST_MCS51_COMPILER_H
@@ -0,0 +1,133 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sim.cpp Simulated SFR/port model.
+ * @author Thomas Reidemeister
+ */
+#include <cstdint>
+
+#include <mcs51/8051.h>
+
+#include "delay.h"
+#include "sim.h"
+
+uint32_t sim_time = 0;
+std::vector<sim_event> sim_log;
+std::function<void(const sim_sfr &)> sim_on_write;
+
+struct pending_drive {
+  uint32_t time;
+  sim_sfr *port;
+  uint8_t bit;
+  uint8_t level;
+};
+static std::vector<pending_drive> pending; // Sorted by time
+
+static bool is_port(const sim_sfr &s) {
+  return (s.addr & 0xCF) == 0x80; // P0 0x80, P1 0x90, P2 0xA0, P3 0xB0
+}
+
+// Apply scheduled external drives that are due by now, logged at their own time
+static void run_pending(void) {
+  uint32_t now = sim_time;
+  while(!pending.empty() && pending.front().time <= now) {
+    pending_drive d = pending.front();
+    pending.erase(pending.begin());
+    sim_time = d.time;
+    sim_drive(*d.port, d.bit, d.level);
+  }
+  sim_time = now;
+}
+
+uint8_t sim_sfr::read() {
+  sim_time++;
+  run_pending();
+  return is_port(*this) ? (latch & ext) : latch;
+}
+
+static void log_level(sim_sfr &s, uint8_t before) {
+  uint8_t level = s.latch & s.ext;
+  if(level != before) {
+    sim_log.push_back({sim_time, s.addr, level});
+  }
+}
+
+void sim_sfr::write(uint8_t v) {
+  sim_time++;
+  run_pending();
+  if(v == latch && addr != 0x99) // Writing SBUF sends even an unchanged byte
+    return;
+  uint8_t before = latch & ext;
+  latch = v;
+  if(is_port(*this)) {
+    log_level(*this, before);
+  }
+  if(sim_on_write) {
+    sim_on_write(*this);
+  }
+}
+
+void sim_reset(void) {
+  sim_sfr *ports[] = {&P0, &P1, &P2, &P3};
+  for(sim_sfr *p : ports) {
+    p->latch = 0xFF;
+    p->ext = 0xFF;
+  }
+  sim_time = 0;
+  sim_log.clear();
+  pending.clear();
+}
+
+void sim_advance(uint32_t cycles) {
+  sim_time += cycles;
+  run_pending();
+}
+
+void sim_drive(sim_sfr &port, uint8_t bit, uint8_t level) {
+  uint8_t before = port.latch & port.ext;
+  if(level) {
+    port.ext |= (1 << bit);
+  } else {
+    port.ext &= ~(1 << bit);
+  }
+  log_level(port, before);
+}
+
+void sim_drive_at(sim_sfr &port, uint8_t bit, uint8_t level, uint32_t time) {
+  auto it = pending.begin();
+  while(it != pending.end() && it->time <= time)
+    it++;
+  pending.insert(it, {time, &port, bit, level});
+}
+
+uint8_t sim_level_at(const sim_sfr &port, uint8_t bit, uint32_t time) {
+  uint8_t v = 0xFF; // Ports come out of reset released
+  for(const sim_event &e : sim_log) {
+    if(e.time > time)
+      break;
+    if(e.addr == port.addr)
+      v = e.value;
+  }
+  return (v >> bit) & 1;
+}
+
+// Host replacements for the assembly loops in lib/delay/, cycles as in delay.h (argument load, lcall and ret)
+void delay_loop8(uint8_t n) {
+  sim_advance(6 + 2 * (n ? n : 256));
+}
+
+void delay_loop16(uint16_t n) {
+  uint16_t l = (n & 0xFF) ? (n & 0xFF) : 256;
+  uint16_t h = (n >> 8) ? (n >> 8) : 256;
+  sim_advance(2 * l + 514 * h - 506);
+}
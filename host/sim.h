@@ -0,0 +1,107 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sim.h Simulated SFR/port model for building the drivers on the host.
+ * @author Thomas Reidemeister
+ */
+#ifndef SIM_H
+#define SIM_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Every access to a special function register goes through sim_sfr/sim_sbit, which advance the simulated
+ * cycle counter (one machine cycle per access) and record every change of a port pin with its timestamp.
+ *
+ * Ports are modelled quasi-bidirectional like on the 8051: the level read back is the latch ANDed with
+ * whatever external devices pull low (see sim_drive()).
+ */
+
+struct sim_sfr;
+
+struct sim_event {
+  uint32_t time;  // Simulated machine cycle of the write
+  uint8_t addr;   // SFR address
+  uint8_t value;  // New pin levels (latch AND external pull-downs)
+};
+
+extern uint32_t sim_time;                  // Simulated machine cycles since sim_reset()
+extern std::vector<sim_event> sim_log;     // Pin level changes of P0..P3 since sim_reset()
+extern std::function<void(const sim_sfr &)> sim_on_write; // Device models hook in here
+
+struct sim_sfr {
+  uint8_t addr;
+  uint8_t latch;
+  uint8_t ext;   // External pull-downs (ports only), 1 = released
+
+  uint8_t read();
+  void write(uint8_t v);
+
+  operator uint8_t() { return read(); }
+  sim_sfr &operator=(unsigned v) { write(v); return *this; }
+  sim_sfr &operator&=(unsigned v) { write(latch & v); return *this; }
+  sim_sfr &operator|=(unsigned v) { write(latch | v); return *this; }
+  sim_sfr &operator^=(unsigned v) { write(latch ^ v); return *this; }
+};
+
+struct sim_sbit {
+  sim_sfr &sfr;
+  uint8_t bit;
+
+  operator bool() { return (sfr.read() >> bit) & 1; }
+  sim_sbit &operator=(unsigned v) {
+    sfr.write(v ? (sfr.latch | (1 << bit)) : (sfr.latch & ~(1 << bit)));
+    return *this;
+  }
+  sim_sbit &operator=(sim_sbit &o) { return *this = (unsigned)(bool)o; }
+};
+
+/**
+ * Clear the log, time and all latches (ports to 0xFF as after reset).
+ */
+void sim_reset(void);
+
+/**
+ * Let time pass without bus activity.
+ * @param cycles Machine cycles
+ */
+void sim_advance(uint32_t cycles);
+
+/**
+ * Pull a port pin low from outside (or release it).
+ * @param port Port SFR
+ * @param bit Pin 0-7
+ * @param level 0 to pull low, 1 to release
+ */
+void sim_drive(sim_sfr &port, uint8_t bit, uint8_t level);
+
+/**
+ * Schedule sim_drive() for a later point in time (e.g. a device response pulse).
+ * @param port Port SFR
+ * @param bit Pin 0-7
+ * @param level 0 to pull low, 1 to release
+ * @param time Simulated machine cycle, applied on the first access or sim_advance() reaching it
+ */
+void sim_drive_at(sim_sfr &port, uint8_t bit, uint8_t level, uint32_t time);
+
+/**
+ * Level of a port pin at a point in time, reconstructed from sim_log.
+ * @param port Port SFR
+ * @param bit Pin 0-7
+ * @param time Simulated machine cycle
+ */
+uint8_t sim_level_at(const sim_sfr &port, uint8_t bit, uint32_t time);
+
+#endif // SIM_H
@@ -0,0 +1,1332 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file trace.cpp Capture and decode the bit-bang waveforms of the drivers on the host.
+ * @author Thomas Reidemeister
+ */
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <mcs51/8052.h>
+
+#include "at24c02.h"
+#include "debounce.h"
+#include "delay.h"
+#include "ds18b20.h"
+#include "hd44780.h"
+#include "hd44780_con.h"
+#include "i2c.h"
+#include "hc595.h"
+#include "keypad.h"
+#include "matrix.h"
+#include "nec.h"
+#include "power.h"
+#include "sched.h"
+#include "segment.h"
+#include "sim.h"
+#include "st7920.h"
+#include "st7920_fb.h"
+#include "timebase.h"
+#include "timer.h"
+#include "uart.h"
+#include "wire.h"
+
+/**
+ * Runs the driver primitives against the port model, prints the bus traffic decoded back from the
+ * recorded pin transitions and optionally writes a VCD per protocol (one time unit = one machine cycle).
+ * The decoded bytes and the bus timing are checked against the expected values, any mismatch is reported
+ * and makes the exit status non-zero (meson test).
+ *
+ * usage: host_trace [vcd output directory]
+ */
+
+struct signal {
+  const char *name;
+  sim_sfr &port;
+  uint8_t bit;
+};
+
+static const char *vcd_dir = nullptr;
+static unsigned failures = 0;
+
+// Check one decoded result, a mismatch is reported below the trace line and fails the run
+static void expect(bool ok, const char *what) {
+  if(ok)
+    return;
+  printf("  FAIL: %s\n", what);
+  failures++;
+}
+
+// Write the logged pins as a VCD, a file that cannot be written counts as a failed check
+static void write_vcd(const char *file, const std::vector<signal> &signals) {
+  if(!vcd_dir)
+    return;
+  std::string path = std::string(vcd_dir) + "/" + file;
+  FILE *f = fopen(path.c_str(), "w");
+  if(!f) {
+    perror(path.c_str());
+    failures++;
+    return;
+  }
+  fprintf(f, "$timescale 1us $end\n$scope module stc89c52 $end\n");
+  for(size_t i = 0; i < signals.size(); i++) {
+    fprintf(f, "$var wire 1 %c %s $end\n", (char)('!' + i), signals[i].name);
+  }
+  fprintf(f, "$upscope $end\n$enddefinitions $end\n#0\n");
+  std::vector<uint8_t> level(signals.size(), 1);
+  for(size_t i = 0; i < signals.size(); i++) {
+    fprintf(f, "1%c\n", (char)('!' + i));
+  }
+  for(const sim_event &e : sim_log) {
+    bool stamped = false;
+    for(size_t i = 0; i < signals.size(); i++) {
+      uint8_t v = (e.value >> signals[i].bit) & 1;
+      if(e.addr != signals[i].port.addr || v == level[i])
+        continue;
+      if(!stamped) {
+        fprintf(f, "#%u\n", e.time);
+        stamped = true;
+      }
+      fprintf(f, "%u%c\n", v, (char)('!' + i));
+      level[i] = v;
+    }
+  }
+  fprintf(f, "#%u\n", sim_time);
+  if(ferror(f) | fclose(f)) {
+    perror(path.c_str());
+    failures++;
+  }
+}
+
+// Rising/falling edges of one pin as (time, new level)
+static std::vector<std::pair<uint32_t, uint8_t>> edges(const sim_sfr &port, uint8_t bit) {
+  std::vector<std::pair<uint32_t, uint8_t>> out;
+  uint8_t level = 1;
+  for(const sim_event &e : sim_log) {
+    if(e.addr != port.addr)
+      continue;
+    uint8_t v = (e.value >> bit) & 1;
+    if(v != level) {
+      out.push_back({e.time, v});
+      level = v;
+    }
+  }
+  return out;
+}
+
+// Serial bytes clocked into the ST7920 after start
+static std::vector<uint8_t> st7920_bytes(uint32_t start) {
+  std::vector<uint8_t> out;
+  uint8_t byte = 0, bits = 0;
+  for(auto &e : edges(P2, 7)) { // SID sampled on rising SCLK while CS is high
+    if(e.first > start && e.second && sim_level_at(P2, 6, e.first)) {
+      byte = (byte << 1) | sim_level_at(P2, 5, e.first);
+      if(++bits == 8) {
+        out.push_back(byte);
+        bits = 0;
+      }
+    }
+  }
+  return out;
+}
+
+static void trace_st7920(void) {
+  sim_reset();
+  ST7920_CS = 0;
+  ST7920_SCLK = 0;
+  uint32_t start = sim_time;
+  st7920_data('A');
+
+  std::vector<uint8_t> bytes = st7920_bytes(start);
+  printf("st7920_data('A'):");
+  for(uint8_t b : bytes) {
+    printf(" %02X", b);
+  }
+  printf(" (%u cycles)\n", sim_time);
+  expect(bytes == std::vector<uint8_t>{0xFA, 0x40, 0x10}, "st7920_data('A') sends sync FA and 'A' as 40 10");
+  write_vcd("st7920.vcd", {{"sclk", P2, 7}, {"cs", P2, 6}, {"sid", P2, 5}});
+}
+
+static void trace_st7920_fb(void) {
+  sim_reset();
+  ST7920_CS = 0;
+  ST7920_SCLK = 0;
+  st7920_fb_band(40);
+  st7920_fb_fill(0x00);
+  st7920_fb_validate();
+  st7920_fb_word(0, 40, 0xFFFF); // One run of two words and a single word
+  st7920_fb_word(1, 40, 0xFFFF);
+  st7920_fb_word(5, 40, 0x8001);
+  st7920_fb_word(2, 39, 0xFFFF); // Outside the band, ignored
+  st7920_fb_pixel(0, 40 + ST7920_FB_ROWS, 1);
+  uint32_t start = sim_time;
+  st7920_fb_flush();
+
+  uint32_t data = 0, cmds = 0;
+  std::vector<uint8_t> bytes = st7920_bytes(start);
+  for(size_t i = 0; i < bytes.size(); i++) { // Sync bytes have a non zero low nibble, data nibbles do not
+    if(bytes[i] == 0xF8) {
+      cmds++;
+      i += 2;
+    } else if(bytes[i] != 0xFA) {
+      data++;
+      i++;
+    }
+  }
+  printf("st7920_fb_flush(3 words, 2 runs): %u data, %u commands, %zu serial bytes (%u cycles)\n", data, cmds,
+         bytes.size(), sim_time - start);
+  expect(data == 6 && cmds == 4 && bytes.size() == 26, "st7920_fb_flush() sends 6 data bytes and 2 addresses");
+  expect(bytes.size() > 6 && std::equal(bytes.begin(), bytes.begin() + 6,
+                                        std::vector<uint8_t>{0xF8, 0x80, 0x80, 0xF8, 0x80, 0x80}.begin()),
+         "band row 0 goes to display row 40 (lower half: Y 8, X 8)");
+
+  // Running line step of the graph demo: band loaded from the picture on the display, line moves by one word
+  static uint8_t picture[ST7920_FB_HEIGHT * ST7920_FB_STRIDE];
+  for(size_t i = 0; i < sizeof(picture); i++) {
+    picture[i] = i * 37;
+  }
+  st7920_fb_band(8);
+  st7920_fb_blit(picture);
+  st7920_fb_validate();
+  start = sim_time;
+  st7920_fb_flush();
+  size_t clean = st7920_bytes(start).size();
+  st7920_fb_word(3, 12, 0xFFFF);
+  start = sim_time;
+  st7920_fb_flush();
+  size_t first = st7920_bytes(start).size();
+  st7920_fb_blit(picture); // Restore
+  st7920_fb_word(4, 12, 0xFFFF);
+  start = sim_time;
+  st7920_fb_flush();
+  size_t step = st7920_bytes(start).size();
+  printf("st7920_fb_validate(band 8, line step): %zu, %zu and %zu serial bytes\n", clean, first, step);
+  expect(clean == 0 && first == 6 + 1 + 4 && step == 6 + 1 + 8,
+         "a validated band flushes nothing, then only the line word and the restored word in one run");
+}
+
+// I2C slave acknowledging every byte: pulls SDA low after the 8th clock until the end of the 9th
+static uint8_t i2c_clocks;
+static uint8_t i2c_bus = 0x03; // SCL, SDA latches seen last
+
+static void i2c_device(const sim_sfr &s) {
+  if(s.addr != P2.addr)
+    return;
+  uint8_t bus = P2.latch & 0x03;
+  uint8_t changed = bus ^ i2c_bus;
+  i2c_bus = bus;
+  if((changed & 0x01) && (bus & 0x02)) { // SDA moved while SCL high: START/STOP
+    i2c_clocks = 0;
+  } else if((changed & 0x02) && (bus & 0x02)) {
+    i2c_clocks++;
+  } else if((changed & 0x02) && i2c_clocks == 8) {
+    sim_drive(P2, 0, 0); // ACK
+  } else if((changed & 0x02) && i2c_clocks == 9) {
+    sim_drive(P2, 0, 1);
+    i2c_clocks = 0;
+  }
+}
+
+// Bus traffic as " S A0 A 00 A 55 N P": START/STOP and every byte with the acknowledge bit that followed it
+static std::string i2c_transfers(void) {
+  std::string bus;
+  uint8_t sda = 1, scl = 1, byte = 0, bits = 0;
+  for(const sim_event &e : sim_log) { // Bus level after every transition
+    if(e.addr != P2.addr)
+      continue;
+    uint8_t nsda = e.value & 1, nscl = (e.value >> 1) & 1;
+    if(scl && nscl && sda != nsda) {
+      bus += nsda ? " P" : " S";
+      bits = 0;
+    } else if(!scl && nscl) {
+      if(bits < 8) {
+        byte = (byte << 1) | nsda;
+      } else {
+        char b[8];
+        snprintf(b, sizeof(b), " %02X %s", byte, nsda ? "N" : "A");
+        bus += b;
+      }
+      bits = (bits + 1) % 9;
+    }
+    sda = nsda;
+    scl = nscl;
+  }
+  return bus;
+}
+
+static void trace_i2c(void) {
+  sim_reset();
+  i2c_clocks = 0;
+  i2c_bus = 0x03;
+  sim_on_write = i2c_device;
+  static const uint8_t data[] = {0x00, 0x55};
+  uint8_t ack = i2c_write_buf(0xA0, data, sizeof(data));
+  sim_on_write = nullptr;
+
+  std::string bus = i2c_transfers();
+  uint8_t sda = 1, scl = 1;
+  uint32_t rise = 0, fall = 0, period = UINT32_MAX, low = UINT32_MAX, high = UINT32_MAX;
+  for(const sim_event &e : sim_log) { // SCL timing between START and STOP
+    if(e.addr != P2.addr)
+      continue;
+    uint8_t nsda = e.value & 1, nscl = (e.value >> 1) & 1;
+    if(scl && nscl && sda != nsda) {
+      rise = 0;
+      fall = 0;
+    } else if(!scl && nscl) {
+      if(rise)
+        period = std::min(period, e.time - rise);
+      if(fall)
+        low = std::min(low, e.time - fall);
+      rise = e.time;
+    } else if(scl && !nscl) {
+      if(rise)
+        high = std::min(high, e.time - rise);
+      fall = e.time;
+    }
+    sda = nsda;
+    scl = nscl;
+  }
+  printf("i2c_write_buf(0xA0, {00 55}): ack=%u:%s (%u cycles, SCL <= %lukHz)\n", ack, bus.c_str(), sim_time,
+         FOSC / CLOCK_MODE / period / 1000);
+  expect(ack && bus == " S A0 A 00 A 55 A P", "i2c_write_buf() frames address and data with START/STOP, all ACKed");
+  expect(FOSC / CLOCK_MODE / period <= I2C_SPEED && low >= I2C_T_LOW && high >= I2C_T_HIGH,
+         "SCL within the I2C_SPEED clock, low and high times");
+  write_vcd("i2c.vcd", {{"scl", P2, 1}, {"sda", P2, 0}});
+
+  sim_reset();
+  uint8_t buf[1];
+  expect(!i2c_read_buf(0xA0, buf, 0) && sim_log.empty(), "i2c_read_buf() of zero bytes returns 0 without bus traffic");
+
+  sim_reset();
+  I2C_SCL = 0;
+  sim_drive(P2, 1, 0); // Slave stretches the clock for good
+  sim_drive(P2, 0, 0);
+  buf[0] = 0x5A;
+  uint8_t ok = i2c_read(buf, I2C_ACK);
+  sim_drive(P2, 1, 1);
+  sim_drive(P2, 0, 1);
+  expect(!ok && buf[0] == 0x5A, "i2c_read() reports a clock stretching timeout and keeps the byte");
+}
+
+// AT24C02 model: 256 bytes, page writes wrap within AT24C02_PAGE_SIZE, the address is NACKed for
+// AT24C02_MODEL_BUSY polls after a write. Samples SDA on rising SCL and drives it after falling SCL.
+#define AT24C02_MODEL_BUSY 2
+static uint8_t eeprom[256];
+static uint8_t eeprom_ptr;    // Address counter
+static uint8_t eeprom_bus;    // SCL, SDA latches seen last
+static uint8_t eeprom_clocks; // Rising SCL edges of the current byte (9 with the acknowledge)
+static uint8_t eeprom_byte;
+static uint8_t eeprom_index;  // Byte of the transfer, 0 is the device address
+static uint8_t eeprom_read, eeprom_ignore, eeprom_written, eeprom_master_ack, eeprom_busy;
+
+static void at24c02_device(const sim_sfr &s) {
+  if(s.addr != P2.addr)
+    return;
+  uint8_t bus = P2.latch & 0x03;
+  uint8_t changed = bus ^ eeprom_bus;
+  eeprom_bus = bus;
+  if((changed & 0x01) && (bus & 0x02)) { // SDA moved while SCL high: START/STOP
+    if((bus & 0x01) && eeprom_written)
+      eeprom_busy = AT24C02_MODEL_BUSY; // STOP starts the write cycle
+    eeprom_clocks = eeprom_index = eeprom_read = eeprom_ignore = eeprom_written = 0;
+    sim_drive(P2, 0, 1);
+    return;
+  }
+  if(!(changed & 0x02) || eeprom_ignore)
+    return;
+  uint8_t sending = eeprom_read && eeprom_index;
+  if(bus & 0x02) { // SCL rising
+    if(++eeprom_clocks <= 8)
+      eeprom_byte = (eeprom_byte << 1) | (bus & 0x01);
+    else if(sending)
+      eeprom_master_ack = !(bus & 0x01);
+    return;
+  }
+  if(eeprom_clocks == 8) { // Acknowledge slot
+    if(sending) {
+      sim_drive(P2, 0, 1); // The master acknowledges
+      return;
+    }
+    uint8_t ack = 1;
+    if(eeprom_index == 0) {
+      ack = (eeprom_byte & 0xFE) == AT24C02_ADDR && !eeprom_busy;
+      if(eeprom_busy)
+        eeprom_busy--;
+      eeprom_read = eeprom_byte & 0x01;
+    } else if(eeprom_index == 1) {
+      eeprom_ptr = eeprom_byte;
+    } else {
+      eeprom[eeprom_ptr] = eeprom_byte;
+      eeprom_ptr = (eeprom_ptr & ~(AT24C02_PAGE_SIZE - 1)) | ((eeprom_ptr + 1) & (AT24C02_PAGE_SIZE - 1));
+      eeprom_written = 1;
+    }
+    if(ack)
+      sim_drive(P2, 0, 0);
+    else
+      eeprom_ignore = 1; // Until the next START/STOP
+  } else if(eeprom_clocks == 9) {
+    sim_drive(P2, 0, 1);
+    eeprom_clocks = 0;
+    if(sending)
+      eeprom_ptr++; // Sequential reads wrap at the end of the memory
+    eeprom_index++;
+    if(eeprom_read && (eeprom_index == 1 || eeprom_master_ack))
+      sim_drive(P2, 0, eeprom[eeprom_ptr] >> 7);
+    else if(sending)
+      eeprom_ignore = 1; // NACK ends the read
+  } else if(sending && eeprom_clocks >= 1 && eeprom_clocks < 8) {
+    sim_drive(P2, 0, (eeprom[eeprom_ptr] >> (7 - eeprom_clocks)) & 1);
+  }
+}
+
+static void trace_at24c02(void) {
+  sim_reset();
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  eeprom_bus = 0x03;
+  eeprom_busy = 0;
+  eeprom_clocks = eeprom_index = eeprom_read = eeprom_ignore = eeprom_written = 0;
+  sim_on_write = at24c02_device;
+  static const uint8_t data[] = {0x11, 0x22, 0x33, 0x44};
+  uint8_t written = at24c02_write_page(0x06, data, sizeof(data)); // 2 bytes to the end of the page, 2 into the next
+  std::string wr = i2c_transfers();
+  sim_reset();
+  uint8_t buf[4] = {0};
+  uint8_t read = at24c02_read_seq(0x06, buf, sizeof(buf));
+  std::string rd = i2c_transfers();
+  sim_reset();
+  uint8_t none = at24c02_read_seq(0x06, buf, 0);
+  sim_on_write = nullptr;
+
+  printf("at24c02_write_page(0x06, 4 bytes): %u:%s\n", written, wr.c_str());
+  printf("at24c02_read_seq(0x06, 4): %u:%s\n", read, rd.c_str());
+  std::string poll = " S A0 N P S A0 N P S A0 A P"; // Write cycle, AT24C02_MODEL_BUSY NACKs
+  expect(written && wr == " S A0 A 06 A 11 A 22 A P" + poll + " S A0 A 08 A 33 A 44 A P" + poll,
+         "at24c02_write_page() splits at the page boundary and polls for the write cycle after each page");
+  expect(eeprom[6] == 0x11 && eeprom[7] == 0x22 && eeprom[8] == 0x33 && eeprom[9] == 0x44 && eeprom[0] == 0xFF,
+         "page writes land at their addresses without wrapping");
+  expect(read && rd == " S A0 A 06 A S A1 A 11 A 22 A 33 A 44 N P" && !memcmp(buf, data, sizeof(data)),
+         "at24c02_read_seq() ACKs every byte but the last, which is NACKed");
+  expect(!none && sim_log.empty(), "at24c02_read_seq() of zero bytes returns 0 without bus traffic");
+}
+
+// 1-Wire device answering a reset pulse (>= 480us low) with a presence pulse
+static uint32_t wire_fall;
+static uint8_t wire_dq = 1;
+
+static void wire_device(const sim_sfr &s) {
+  if(s.addr != P3.addr || ((P3.latch >> 7) & 1) == wire_dq)
+    return;
+  wire_dq = (P3.latch >> 7) & 1;
+  if(!wire_dq) {
+    wire_fall = sim_time;
+  } else if(sim_time - wire_fall >= 480) {
+    sim_drive_at(P3, 7, 0, sim_time + 30);  // Presence after 15-60us
+    sim_drive_at(P3, 7, 1, sim_time + 150); // for 60-240us
+  }
+}
+
+static void trace_wire(void) {
+  sim_reset();
+  wire_dq = 1;
+  sim_on_write = wire_device;
+  wire_init();
+  uint32_t start = sim_time;
+  wire_write_byte(0xCC);
+  sim_on_write = nullptr;
+
+  std::string bus;
+  uint32_t fall = 0, slot = 0, slot_min = UINT32_MAX, recovery_min = UINT32_MAX;
+  uint8_t byte = 0, bits = 0;
+  for(auto &e : edges(P3, 7)) {
+    if(!e.second) {
+      if(slot && fall >= start)
+        slot_min = std::min(slot_min, e.first - fall);
+      if(slot)
+        recovery_min = std::min(recovery_min, e.first - slot);
+      fall = e.first;
+    } else if(e.first - fall >= US_TO_CYCLES(480)) {
+      bus += " reset";
+    } else if(fall >= start) { // Device samples 15-60us into the slot
+      byte = (byte >> 1) | (sim_level_at(P3, 7, fall + US_TO_CYCLES(15)) << 7);
+      slot = e.first;
+      if(++bits == 8) {
+        char b[4];
+        snprintf(b, sizeof(b), " %02X", byte);
+        bus += b;
+        bits = 0;
+      }
+    }
+  }
+  printf("wire_init/wire_write_byte(0xCC):%s (%u cycles)\n", bus.c_str(), sim_time);
+  expect(bus == " reset CC", "wire_init() resets the bus, wire_write_byte() sends CC LSB first");
+  expect(slot_min >= US_TO_CYCLES(60) && recovery_min >= 1, "1-Wire write slots of at least 60us with recovery");
+  write_vcd("wire.vcd", {{"dq", P3, 7}});
+}
+
+// Several 1-Wire devices answering Search ROM, Match ROM/Skip ROM, Convert T and Read Scratchpad
+static const uint8_t wire_bus_count = 3;
+static uint8_t wire_bus_rom[wire_bus_count][WIRE_ROM_SIZE] = {
+  {0x28, 0x61, 0x64, 0x12, 0x3C, 0x7A, 0x01}, // DS18B20
+  {0x28, 0xFF, 0x4B, 0x90, 0x53, 0x16, 0x04}, // DS18B20
+  {0x10, 0x61, 0x64, 0x12, 0x3C, 0x7A, 0x02}, // DS18S20, skipped by ds18b20_scan()
+};
+static uint8_t wire_bus_scratchpad[wire_bus_count][DS18B20_SCRATCHPAD_SIZE] = {
+  {0x91, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x0F, 0x10}, // 25.0625C
+  {0x5E, 0xFF, 0x4B, 0x46, 0x7F, 0xFF, 0x02, 0x10}, // -10.125C
+  {0xAA, 0x00, 0x4B, 0x46, 0xFF, 0xFF, 0x0C, 0x10},
+};
+enum wire_bus_phase { WIRE_BUS_ROM, WIRE_BUS_SEARCH, WIRE_BUS_MATCH, WIRE_BUS_FUNC, WIRE_BUS_SEND, WIRE_BUS_CONVERT,
+                      WIRE_BUS_IDLE };
+static const uint32_t wire_bus_convert_time = 20000; // Shortened, a real 12-bit conversion takes 750ms
+static wire_bus_phase wire_bus_phase;
+static uint8_t wire_bus_active; // Bit d set while device d takes part
+static uint8_t wire_bus_byte, wire_bus_bits;
+static uint16_t wire_bus_slot;  // Search: bit * 3 + (id, complement, direction), send: bit of the scratchpad
+static uint32_t wire_bus_converted; // End of the running conversion
+
+static uint8_t wire_bus_bit(const uint8_t *data, uint16_t bit) {
+  return (data[bit >> 3] >> (bit & 7)) & 1;
+}
+
+// Wired AND of what the active devices put on the bus in a read slot
+static uint8_t wire_bus_answer(void) {
+  uint8_t level = 1;
+  if(wire_bus_phase == WIRE_BUS_CONVERT)
+    return sim_time >= wire_bus_converted;
+  for(uint8_t d = 0; d < wire_bus_count; d++) {
+    if(wire_bus_active & (1 << d)) {
+      if(wire_bus_phase == WIRE_BUS_SEARCH) {
+        level &= wire_bus_bit(wire_bus_rom[d], wire_bus_slot / 3) ^ (wire_bus_slot % 3);
+      } else {
+        level &= wire_bus_bit(wire_bus_scratchpad[d], wire_bus_slot);
+      }
+    }
+  }
+  return level;
+}
+
+static void wire_bus_write(uint8_t bit) {
+  if(wire_bus_phase == WIRE_BUS_SEARCH) {
+    for(uint8_t d = 0; d < wire_bus_count; d++) {
+      if(wire_bus_bit(wire_bus_rom[d], wire_bus_slot / 3) != bit)
+        wire_bus_active &= ~(1 << d);
+    }
+    if(++wire_bus_slot == WIRE_ROM_SIZE * 8 * 3)
+      wire_bus_phase = WIRE_BUS_IDLE;
+    return;
+  }
+  if(wire_bus_phase == WIRE_BUS_MATCH) {
+    for(uint8_t d = 0; d < wire_bus_count; d++) {
+      if(wire_bus_bit(wire_bus_rom[d], wire_bus_slot) != bit)
+        wire_bus_active &= ~(1 << d);
+    }
+    if(++wire_bus_slot == WIRE_ROM_SIZE * 8)
+      wire_bus_phase = WIRE_BUS_FUNC;
+    return;
+  }
+  wire_bus_byte = (wire_bus_byte >> 1) | (bit << 7);
+  if(++wire_bus_bits < 8)
+    return;
+  wire_bus_bits = 0;
+  wire_bus_slot = 0;
+  if(wire_bus_phase == WIRE_BUS_ROM) {
+    wire_bus_phase = wire_bus_byte == WIRE_SEARCH_ROM ? WIRE_BUS_SEARCH
+                   : wire_bus_byte == WIRE_MATCH_ROM ? WIRE_BUS_MATCH : WIRE_BUS_FUNC;
+  } else if(wire_bus_phase == WIRE_BUS_FUNC) {
+    wire_bus_phase = wire_bus_byte == DS18B20_READ_SCRATCHPAD ? WIRE_BUS_SEND
+                   : wire_bus_byte == DS18B20_CONVERT_T ? WIRE_BUS_CONVERT : WIRE_BUS_IDLE;
+    wire_bus_converted = sim_time + wire_bus_convert_time;
+  }
+}
+
+static void wire_bus_device(const sim_sfr &s) {
+  if(s.addr != P3.addr || ((P3.latch >> 7) & 1) == wire_dq)
+    return;
+  wire_dq = (P3.latch >> 7) & 1;
+  uint8_t reading = (wire_bus_phase == WIRE_BUS_SEARCH && wire_bus_slot % 3 != 2) || wire_bus_phase == WIRE_BUS_SEND
+                  || wire_bus_phase == WIRE_BUS_CONVERT;
+  if(!wire_dq) {
+    wire_fall = sim_time;
+    if(reading && !wire_bus_answer()) { // Hold the slot low past the master's sampling point
+      sim_drive(P3, 7, 0);
+      sim_drive_at(P3, 7, 1, sim_time + 30);
+    }
+  } else if(sim_time - wire_fall >= 480) {
+    sim_drive_at(P3, 7, 0, sim_time + 30);
+    sim_drive_at(P3, 7, 1, sim_time + 150);
+    wire_bus_phase = WIRE_BUS_ROM;
+    wire_bus_active = (1 << wire_bus_count) - 1;
+    wire_bus_bits = 0;
+  } else if(reading) {
+    if(wire_bus_phase == WIRE_BUS_CONVERT) {
+      // Ready flag slot, no state change
+    } else if(wire_bus_phase == WIRE_BUS_SEARCH) {
+      wire_bus_slot++;
+    } else if(++wire_bus_slot == DS18B20_SCRATCHPAD_SIZE * 8) {
+      wire_bus_phase = WIRE_BUS_IDLE;
+    }
+  } else if(wire_bus_phase != WIRE_BUS_IDLE) {
+    wire_bus_write(sim_time - wire_fall < US_TO_CYCLES(15));
+  }
+}
+
+static void trace_ds18b20(void) {
+  static const uint8_t maxim[] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00}; // CRC A2 (Maxim AN27)
+  for(uint8_t d = 0; d < wire_bus_count; d++) {
+    wire_bus_rom[d][WIRE_ROM_SIZE - 1] = wire_crc8(wire_bus_rom[d], WIRE_ROM_SIZE - 1);
+    wire_bus_scratchpad[d][DS18B20_SCRATCHPAD_SIZE - 1] = wire_crc8(wire_bus_scratchpad[d], DS18B20_SCRATCHPAD_SIZE - 1);
+  }
+  sim_reset();
+  wire_dq = 1;
+  wire_bus_phase = WIRE_BUS_IDLE;
+  sim_on_write = wire_bus_device;
+  static const int16_t temps[] = {401, -162}; // Scratchpads of the two DS18B20
+  uint8_t crc = wire_crc8(maxim, sizeof(maxim));
+  uint8_t found = ds18b20_scan();
+  printf("wire_crc8(AN27 example): %02X,", crc);
+  printf(" ds18b20_scan(3 devices): %u", found);
+  expect(crc == 0xA2, "wire_crc8() of the AN27 example is A2");
+  expect(found == 2, "ds18b20_scan() finds the two DS18B20 and skips the DS18S20");
+  for(uint8_t i = 0; i < ds18b20_count; i++) {
+    int16_t raw = 0;
+    uint8_t ok = ds18b20_read(i, &raw);
+    expect(ok && i < 2 && raw == temps[i] && std::equal(ds18b20_rom[i], ds18b20_rom[i] + WIRE_ROM_SIZE,
+                                                         wire_bus_rom[i]),
+           "ds18b20_read() addresses each ROM and reads its temperature");
+    printf(" [");
+    for(uint8_t b = 0; b < WIRE_ROM_SIZE; b++) {
+      printf("%02X", ds18b20_rom[i][b]);
+    }
+    printf("] %s %d/16C", ok ? "ok" : "crc error", raw);
+  }
+  sim_on_write = nullptr;
+  printf(" (%u cycles)\n", sim_time);
+
+  // Conversion round stepped like from the main loop, a timer tick every 1000 cycles
+  EA = 1;
+  uint32_t masked = 0, masked_max = 0;
+  sim_on_write = [&](const sim_sfr &s) {
+    if(s.addr == IE.addr) {
+      if(!(s.latch & 0x80)) {
+        masked = sim_time;
+      } else {
+        masked_max = std::max(masked_max, sim_time - masked);
+      }
+    }
+    wire_bus_device(s);
+  };
+  uint32_t start = sim_time, tick = sim_time, step_max = 0;
+  uint16_t steps = 0;
+  ds18b20_start(800);
+  for(uint8_t done = 0; !done; steps++) {
+    uint32_t step = sim_time;
+    done = ds18b20_poll();
+    step_max = std::max(step_max, sim_time - step);
+    sim_advance(50); // Rest of the main loop
+    for(; sim_time - tick >= 1000; tick += 1000) {
+      ds18b20_tick();
+    }
+  }
+  sim_on_write = nullptr;
+  printf("ds18b20_poll(round): %u steps, valid %02X,", steps, ds18b20_valid);
+  for(uint8_t i = 0; i < ds18b20_count; i++) {
+    printf(" %d/16C", ds18b20_temp[i]);
+  }
+  printf(" (%u cycles, longest step %u, interrupts masked <= %u)\n", sim_time - start, step_max, masked_max);
+  expect(ds18b20_valid == 0x03 && ds18b20_temp[0] == temps[0] && ds18b20_temp[1] == temps[1],
+         "ds18b20_poll() converts and reads both sensors");
+  expect(masked_max <= US_TO_CYCLES(65), "interrupts masked for at most one 1-Wire slot (65us)");
+
+  // Fixed-point conversion against the floating point result over the whole sensor range
+  uint16_t mismatches = 0;
+  for(int16_t raw = -55 * 16; raw <= 125 * 16; raw++) {
+    uint8_t bcd[4];
+    uint8_t negative = ds18b20_to_bcd(raw, bcd);
+    int tenths = bcd[3] * 1000 + bcd[2] * 100 + bcd[1] * 10 + bcd[0];
+    int mag = raw < 0 ? -raw : raw;
+    int expect = (mag >> 4) * 10 + ((mag & 0x0F) * 10 + 8) / 16;
+    if(negative != (raw < 0) || tenths != expect || bcd[0] > 9 || bcd[1] > 9 || bcd[2] > 9)
+      mismatches++;
+  }
+  printf("ds18b20_to_bcd(-55..125C): %u mismatches\n", mismatches);
+  expect(!mismatches, "ds18b20_to_bcd() matches the rounded temperature");
+}
+
+// Display contents as text, leftmost digit first
+static std::string segment_text(void) {
+  std::string s;
+  for(int8_t i = SEGMENT_DIGITS - 1; i >= 0; i--) {
+    uint8_t d = segment_digits[i] & ~SEGMENT_DP;
+    char c = d == SEGMENT_MINUS ? '-' : d == SEGMENT_BLANK ? ' ' : '?';
+    for(uint8_t h = 0; h < 16; h++) {
+      if(segment_map[h] == d)
+        c = "0123456789ABCDEF"[h];
+    }
+    s += c;
+    if(segment_digits[i] & SEGMENT_DP)
+      s += '.';
+  }
+  return s;
+}
+
+// 74HC595 on P3: SER shifted in on rising SRCLK, outputs latched on rising RCLK together with the P0 columns
+struct hc595_latch {
+  uint8_t rows;
+  uint8_t cols;
+};
+static uint8_t hc595_shift, hc595_pins;
+static std::vector<hc595_latch> hc595_latches;
+
+static void hc595_device(const sim_sfr &s) {
+  if(s.addr != P3.addr)
+    return;
+  uint8_t rise = P3.latch & ~hc595_pins;
+  hc595_pins = P3.latch;
+  if(rise & 0x40) // SRCLK (P3_6)
+    hc595_shift = (hc595_shift << 1) | ((P3.latch >> 4) & 1);
+  if(rise & 0x20) // RCLK (P3_5)
+    hc595_latches.push_back({hc595_shift, P0.latch});
+}
+
+// Frame 0 and 1 hold different patterns, the swap is requested in the middle of a frame
+static void trace_matrix(void) {
+  sim_reset();
+  hc595_pins = P3.latch;
+  hc595_latches.clear();
+  for(uint8_t r = 0; r < MATRIX_ROWS; r++) {
+    matrix_frames[0][r] = 0x11 * (r + 1);
+    matrix_frames[1][r] = ~(0x11 * (r + 1));
+  }
+  matrix_front = 0;
+  matrix_swap_pending = 0;
+  sim_on_write = hc595_device;
+  for(uint8_t i = 0; i < 2 * MATRIX_ROWS + 3; i++) { // matrix_row starts at 0, no other trace scans
+    if(i == MATRIX_ROWS + 3)
+      matrix_swap_pending = 1; // As matrix_swap() sets it before waiting for the scan
+    matrix_scan();
+  }
+  sim_on_write = nullptr;
+
+  uint8_t rows_ok = hc595_latches.size() == 2 * (2 * MATRIX_ROWS + 3), swap_at = 0xFF;
+  for(size_t i = 0; rows_ok && i < hc595_latches.size() / 2; i++) {
+    uint8_t row = i % MATRIX_ROWS;
+    const hc595_latch &off = hc595_latches[2 * i], &on = hc595_latches[2 * i + 1];
+    uint8_t frame = on.cols == (uint8_t)~matrix_frames[1][row];
+    if(frame && swap_at == 0xFF)
+      swap_at = i;
+    rows_ok = off.rows == 0 && on.rows == (0x80 >> row) &&
+              (on.cols == (uint8_t)~matrix_frames[0][row] || frame) && frame == (swap_at != 0xFF);
+  }
+  printf("matrix_scan(19 ticks, swap requested at tick 11): %zu latches, new frame from tick %u\n",
+         hc595_latches.size(), swap_at);
+  expect(rows_ok, "every tick blanks the rows, then drives one row with its P0 column byte");
+  expect(swap_at == 2 * MATRIX_ROWS && matrix_front == 1 && !matrix_swap_pending,
+         "matrix_swap() takes effect at the next frame start, no torn frame");
+}
+
+// Timer interrupt loop: reload from segment_reload, measure how long each digit is lit
+static void trace_segment(void) {
+  sim_reset();
+  P2 = 0x02; // I2C: SDA (P2_0) low, SCL (P2_1) high
+  for(uint8_t i = 0; i < SEGMENT_DIGITS; i++) {
+    segment_digits[i] = segment_map[i];
+  }
+  segment_blink = 0x01;
+  segment_brightness(3);
+  printf("segment_scan(brightness 3/%u, digit 0 blinking):", SEGMENT_LEVELS);
+  uint32_t lit = 0, ticks = 0, interrupts = 0, dark_digit0 = 0;
+  uint8_t p2_ok = 1;
+  while(ticks < 2 * SEGMENT_BLINK_TICKS) {
+    uint32_t start = sim_time;
+    uint8_t tick = segment_scan();
+    ticks += tick;
+    interrupts++;
+    uint8_t on = P0.latch != 0;
+    if(tick && (P2.latch >> SEGMENT_SELECT_SHIFT & 0x07) == 0 && !on)
+      dark_digit0++;
+    p2_ok &= (P2.latch & 0x03) == 0x02;
+    sim_advance(0x10000 - segment_reload - (sim_time - start)); // Rest of the period
+    if(on)
+      lit += sim_time - start;
+  }
+  uint32_t frames = ticks / SEGMENT_DIGITS;
+  printf(" %u interrupts per %u ticks, lit %u%%, digit 0 dark in %u of %u frames, P2_0/P2_1 %s\n", interrupts, ticks,
+         lit * 100 / sim_time, dark_digit0, frames, p2_ok ? "untouched" : "CLOBBERED");
+  expect(p2_ok, "segment_scan() leaves the I2C pins of P2 alone");
+  expect(interrupts + dark_digit0 <= 2 * ticks && interrupts + dark_digit0 + 1 >= 2 * ticks,
+         "one brightness interrupt per tick unless the digit is blinked off");
+  double share = 3.0 / SEGMENT_LEVELS * (1 - 0.5 / SEGMENT_DIGITS); // Digit 0 dark in half of the frames
+  expect(std::abs((double)lit / sim_time - share) < 0.02, "lit for the brightness share of every tick");
+  expect(dark_digit0 + 1 >= frames / 2 && dark_digit0 <= frames / 2 + 1, "blinking digit dark every other period");
+  segment_brightness(SEGMENT_LEVELS);
+  segment_blink = 0;
+}
+
+static void trace_bcd(void) {
+  uint32_t mismatches = 0;
+  uint8_t digits[BCD_U32_DIGITS];
+  for(uint32_t v = 0; v <= 0xFFFF; v++) {
+    bcd_u16(v, digits);
+    uint32_t back = 0;
+    for(int8_t i = BCD_U16_DIGITS - 1; i >= 0; i--) {
+      back = back * 10 + digits[i];
+    }
+    if(back != v)
+      mismatches++;
+  }
+  for(uint32_t v = 1; v < 0xFFFFFFFFUL / 3; v = v * 3 + 1) { // Spread over all digit counts
+    bcd_u32(v, digits);
+    uint64_t back = 0;
+    for(int8_t i = BCD_U32_DIGITS - 1; i >= 0; i--) {
+      back = back * 10 + digits[i];
+    }
+    if(back != v)
+      mismatches++;
+  }
+  std::string shown;
+  segment_s16(-32768, 0);
+  shown += " [" + segment_text() + "]";
+  segment_s16(5, 2);
+  shown += " [" + segment_text() + "]";
+  segment_s8(-128, 1);
+  shown += " [" + segment_text() + "]";
+  segment_u32(99999999, 0);
+  shown += " [" + segment_text() + "]";
+  segment_s32(-9999999, 0);
+  shown += " [" + segment_text() + "]";
+  segment_u32(100000000, 0);
+  shown += " [" + segment_text() + "]";
+  printf("bcd_u16/bcd_u32: %u mismatches, display:%s\n", mismatches, shown.c_str());
+  expect(!mismatches, "bcd_u16()/bcd_u32() convert back to the same value");
+  expect(shown == " [  -32768] [     0.05] [    -12.8] [99999999] [-9999999] [--------]",
+         "segment_s16/s8/u32/s32 place sign, decimal point and overflow dashes");
+}
+
+// Key 6 (row P1_6, column P1_1) shorting its column to ground while its row is driven low
+static uint8_t keypad_closed;
+
+static void keypad_device(const sim_sfr &s) {
+  if(s.addr == P1.addr) {
+    sim_drive(P1, 1, !(keypad_closed && !(P1.latch & 0x40)));
+  }
+}
+
+// Input 0 bounces (never 4 equal samples), input 1 is held for 130 updates, edges recorded per update
+static void trace_debounce(void) {
+  for(uint8_t i = 0; i < 8; i++) {
+    debounce_update(0x00); // Settle whatever earlier samples left
+  }
+  std::vector<uint16_t> pressed[2], released[2], held[2];
+  for(uint16_t i = 0; i < 160; i++) {
+    uint8_t sample = (i < 20 && i % 3 != 2 ? 0x01 : 0) | (i < 130 ? 0x02 : 0);
+    debounce_update(sample);
+    for(uint8_t b = 0; b < 2; b++) {
+      if(debounce_pressed & (1 << b))
+        pressed[b].push_back(i);
+      if(debounce_released & (1 << b))
+        released[b].push_back(i);
+      if(debounce_long & (1 << b))
+        held[b].push_back(i);
+    }
+  }
+  printf("debounce_update(bouncing, held 130): %zu/%zu/%zu edges on the bouncing input, pressed %u long %u released %u\n",
+         pressed[0].size(), released[0].size(), held[0].size(), pressed[1].empty() ? 0 : pressed[1][0],
+         held[1].empty() ? 0 : held[1][0], released[1].empty() ? 0 : released[1][0]);
+  expect(pressed[0].empty() && released[0].empty() && held[0].empty(), "a bouncing input produces no edge");
+  expect(pressed[1] == std::vector<uint16_t>{3}, "a stable press gives one pressed edge on the 4th sample");
+  expect(held[1] == std::vector<uint16_t>{3 + DEBOUNCE_LONG_TICKS - 1},
+         "a held input gives one long edge DEBOUNCE_LONG_TICKS updates after the press");
+  expect(released[1] == std::vector<uint16_t>{133} && !debounce_state, "the release is reported once after 4 samples");
+}
+
+static void trace_keypad(void) {
+  sim_reset();
+  sim_on_write = keypad_device;
+  // Contact closed per 1ms tick: bouncing press, held, bouncing release
+  static const char contact[] = "1010011111111111111110100100000000000000";
+  std::string events;
+  for(uint8_t t = 0; contact[t]; t++) {
+    keypad_closed = contact[t] == '1';
+    keypad_device(P1);
+    keypad_scan();
+    for(uint8_t e; (e = keypad_get()) != KEYPAD_NONE;) {
+      char b[24];
+      snprintf(b, sizeof(b), " %s %u @%ums", (e & KEYPAD_RELEASE) ? "release" : "press", e & 0x0F, t);
+      events += b;
+    }
+  }
+  sim_on_write = nullptr;
+  printf("keypad_scan(key 6 bouncing):%s\n", events.c_str());
+  expect(events == " press 6 @13ms release 6 @37ms", "one press and one release once the contact is stable");
+}
+
+// Timer 0 as restarted by the previous edge: the count and TF0 once the interval exceeds 16 bits
+static void nec_interval(uint32_t cycles) {
+  TH0 = (cycles >> 8) & 0xFF;
+  TL0 = cycles & 0xFF;
+  TF0 = cycles > 0xFFFF;
+  nec_edge();
+}
+
+// Falling edge intervals of an NEC frame (address 0x00, command 0x45) and a repeat code, in microseconds
+static void trace_nec(void) {
+  sim_reset();
+  std::vector<uint32_t> intervals = {13500}; // Leader
+  uint32_t data = 0xFF00 | (uint32_t)(0x45 | (~0x45 & 0xFF) << 8) << 16;
+  for(uint8_t b = 0; b < 32; b++) {
+    intervals.push_back((data >> b) & 1 ? 2250 : 1125);
+  }
+  intervals.push_back(40000); // Repeat leader 108ms after the frame start
+  intervals.push_back(11250); // Repeat stop bit
+
+  nec_interval(0x10000); // First edge after a long idle
+  for(uint32_t us : intervals) {
+    nec_interval(US_TO_CYCLES(us));
+  }
+  nec_interval(2 * 0x10000UL + US_TO_CYCLES(11250)); // Repeat interval on top of two timer wraps: idle, not a repeat
+  std::string frames;
+  for(struct nec_frame f; nec_get(&f);) {
+    char b[40];
+    snprintf(b, sizeof(b), " addr %04X cmd %02X repeat %u", f.address, f.command, f.repeat);
+    frames += b;
+  }
+  printf("nec_edge(frame, repeat):%s\n", frames.c_str());
+  expect(frames == " addr 0000 cmd 45 repeat 0 addr 0000 cmd 45 repeat 1", "nec_edge() decodes the frame and its repeat");
+}
+
+// HD44780 busy for the instruction time after every write, answering busy flag reads on D7 while E is high
+static uint32_t hd44780_busy_until;
+static uint8_t hd44780_nibbles; // 4-bit mode: strobes of the current byte
+static uint8_t hd44780_latched; // Byte assembled from the strobes
+static uint16_t hd44780_early;  // Writes strobed while the controller was still busy
+
+static void hd44780_device(const sim_sfr &s) {
+  if(s.addr != P2.addr)
+    return;
+  uint8_t e = (P2.latch >> 7) & 1, rw = (P2.latch >> 5) & 1;
+  sim_drive(P0, 7, !(e && rw) || sim_time < hd44780_busy_until);
+  static uint8_t last_e = 0;
+  if(last_e && !e && !rw) {
+    hd44780_early += sim_time < hd44780_busy_until;
+#ifdef HD44780_4BIT
+    hd44780_latched = hd44780_nibbles ? hd44780_latched | (P0.latch >> 4) : (P0.latch & 0xF0);
+    if(++hd44780_nibbles < 2) {
+      last_e = e;
+      return;
+    }
+    hd44780_nibbles = 0;
+#else
+    hd44780_latched = P0.latch;
+#endif
+    uint8_t slow = !((P2.latch >> 6) & 1) && hd44780_latched <= (HD44780_RETURN_HOME | 0x01);
+    hd44780_busy_until = sim_time + (slow ? 1520 : 37);
+  }
+  last_e = e;
+}
+
+static void trace_hd44780(void) {
+  sim_reset();
+  HD44780_E = 0;
+  hd44780_busy_until = 0;
+  hd44780_nibbles = 0;
+  hd44780_early = 0;
+  sim_on_write = hd44780_device;
+  uint32_t start = sim_time;
+  hd44780_command(HD44780_DISP_ON);
+  hd44780_data('A');
+  hd44780_wait();
+  uint32_t written = sim_time;
+  hd44780_text("0123456789ABCDEF");
+  hd44780_wait();
+  sim_on_write = nullptr;
+
+  std::string bus;
+  uint8_t d = 0;
+#ifdef HD44780_4BIT
+  uint8_t nibble = 0;
+#endif
+  for(auto &e : edges(P2, 7)) { // Latched on falling E
+    if(e.first > start && e.first < written && !e.second && !sim_level_at(P2, 5, e.first)) {
+      uint8_t v = 0;
+      for(uint8_t b = 0; b < 8; b++) {
+        v |= sim_level_at(P0, b, e.first) << b;
+      }
+#ifdef HD44780_4BIT
+      d = nibble ? d | (v >> 4) : (v & 0xF0);
+      if(!(nibble ^= 1))
+#else
+      d = v;
+#endif
+      {
+        char b[12];
+        snprintf(b, sizeof(b), " %s %02X", sim_level_at(P2, 6, e.first) ? "data" : "cmd", d);
+        bus += b;
+      }
+    }
+  }
+  printf("hd44780_command(0x0C)/hd44780_data('A'):%s (%u cycles), 16 characters %u cycles\n", bus.c_str(),
+         written - start, sim_time - written);
+  expect(bus == " cmd 0C data 41", "hd44780_command()/hd44780_data() latch 0C as command and 'A' as data");
+  expect(!hd44780_early, "no write while the controller is busy");
+  write_vcd("hd44780.vcd", {{"e", P2, 7}, {"rs", P2, 6}, {"rw", P2, 5}, {"d0", P0, 0}, {"d1", P0, 1},
+                            {"d2", P0, 2}, {"d3", P0, 3}, {"d4", P0, 4}, {"d5", P0, 5}, {"d6", P0, 6},
+                            {"d7", P0, 7}});
+}
+
+// Status screen written through the console, then one number changing
+static void trace_hd44780_con(void) {
+  sim_reset();
+  HD44780_E = 0;
+  hd44780_busy_until = 0;
+  hd44780_nibbles = 0;
+  hd44780_early = 0;
+  sim_on_write = hd44780_device;
+  hd44780_con_clear();
+  hd44780_con_invalidate();
+  hd44780_con_printf("T %4d.%u C %5s\n", -12, 5, "ok");
+  hd44780_con_printf("up %05lu %04X", 86399UL, 0xBEEFu);
+  uint8_t full = hd44780_con_flush();
+  uint32_t start = sim_time;
+  hd44780_con_goto(1, 3);
+  hd44780_con_printf("%05lu", 86400UL);
+  uint8_t diff = hd44780_con_flush();
+  uint32_t cycles = sim_time - start;
+  sim_on_write = nullptr;
+  printf("hd44780_con_flush: [%.16s][%.16s] %u bytes, after one update %u bytes (%u cycles)\n", hd44780_con_shown,
+         hd44780_con_shown + HD44780_CON_COLS, full, diff, cycles);
+  std::string shown((const char *)hd44780_con_shown, 2 * HD44780_CON_COLS);
+  expect(shown == "T  -12.5 C    okup 86400 BEEF   ", "hd44780_con_printf() formats both lines");
+  expect(full == 34 && diff == 4, "hd44780_con_flush() sends the whole screen once, then the changed digit only");
+  expect(!hd44780_early, "no write while the controller is busy");
+}
+
+// Serial port: every SBUF write shifts 8N1 out on TXD (P3_1) at the rate set up in Timer 1, TI at the stop bit
+static uint32_t uart_bit;     // Machine cycles per bit
+static uint32_t uart_line_free; // End of the frame on the line
+static uint32_t uart_ti_at;   // TI of the frame being sent
+
+static void uart_device(const sim_sfr &s) {
+  if(s.addr != SBUF.addr)
+    return;
+  uint32_t t = std::max(sim_time, uart_line_free);
+  uint16_t frame = 0x200 | (SBUF.latch << 1); // Start bit, data LSB first, stop bit
+  for(uint8_t b = 0; b < 10; b++) {
+    sim_drive_at(P3, 1, (frame >> b) & 1, t + b * uart_bit);
+  }
+  uart_ti_at = t + 9 * uart_bit;
+  uart_line_free = t + 10 * uart_bit;
+}
+
+// Run the serial interrupt until the ring buffer is empty
+static void uart_drain(void) {
+  while(!uart_tx_idle) {
+    if(TI && ES && EA) {
+      uart_tx_next();
+    } else {
+      sim_advance(uart_ti_at > sim_time ? uart_ti_at - sim_time : 1);
+      TI = 1;
+    }
+  }
+  sim_advance(uart_line_free > sim_time ? uart_line_free - sim_time : 0);
+}
+
+// Receive TXD like a UART at the nominal UART_BAUD, sampling the middle of every bit
+static std::vector<uint8_t> uart_receive(uint32_t start) {
+  std::vector<uint8_t> bytes;
+  double bit = (double)(FOSC / CLOCK_MODE) / UART_BAUD;
+  uint32_t busy_until = start;
+  for(auto &e : edges(P3, 1)) {
+    if(e.second || e.first < busy_until)
+      continue;
+    uint8_t v = 0;
+    for(uint8_t b = 0; b < 8; b++) {
+      v |= sim_level_at(P3, 1, e.first + (uint32_t)(bit * (1.5 + b))) << b;
+    }
+    expect(sim_level_at(P3, 1, e.first + (uint32_t)(bit * 9.5)), "stop bit of every UART byte");
+    bytes.push_back(v);
+    busy_until = e.first + (uint32_t)(bit * 9.5);
+  }
+  return bytes;
+}
+
+static void trace_uart(void) {
+  sim_reset();
+  SBUF = 0x00;
+  uart_tx_head = uart_tx_tail = 0;
+  uart_dropped = 0;
+  uart_init();
+  uart_bit = 16 * (256 - TH1) / ((PCON & SMOD) ? 1 : 2);
+  uart_line_free = 0;
+  sim_on_write = uart_device;
+  ES = 1;
+  EA = 1;
+  uint32_t start = sim_time;
+
+  int16_t fields[3] = {0, 1, -170}; // -10.625C
+  uart_csv("t", fields, 3);
+  fields[0] = 1;
+  fields[2] = 11 * 16 + 1; // "177" checks that a repeated byte is sent
+  uart_csv("t", fields, 3);
+  uint8_t nec[4] = {0x00, 0xFF, 0x45, 0};
+  uart_frame(0x01, nec, sizeof(nec));
+  uint8_t queued = 3;
+  while(uart_csv("t", fields, 3)) { // Fill up, the remaining lines are refused whole
+    queued++;
+  }
+  uint8_t refused = uart_dropped;
+  uart_drain();
+  uint32_t cycles = sim_time - start;
+  sim_on_write = nullptr;
+  EA = 0;
+  ES = 0;
+
+  std::vector<uint8_t> rx = uart_receive(start);
+  printf("uart: %u baud (%lu permille off %u), %u records queued, %u refused, %zu bytes in %u cycles (%.0f%% of the line)\n",
+         (unsigned)(FOSC / CLOCK_MODE / uart_bit), UART_ERROR(UART_T1_CLOCK, UART_BAUD), UART_BAUD, queued,
+         refused, rx.size(), cycles, 100.0 * rx.size() * 10 * uart_bit / cycles);
+  std::string records;
+  for(size_t i = 0; i < rx.size();) {
+    char b[12];
+    if(rx[i] == UART_SYNC && i + 3 < rx.size()) {
+      uint8_t len = rx[i + 2];
+      snprintf(b, sizeof(b), " [type %02X", rx[i + 1]);
+      records += b;
+      for(uint8_t j = 0; j < len; j++) {
+        snprintf(b, sizeof(b), " %02X", rx[i + 3 + j]);
+        records += b;
+      }
+      records += wire_crc8(&rx[i + 1], len + 3) ? " crc BAD]" : " crc ok]";
+      i += len + 4;
+    } else {
+      std::string line;
+      for(; i < rx.size() && rx[i] != '\n'; i++) {
+        if(rx[i] != '\r')
+          line += (char)rx[i];
+      }
+      records += " \"" + line + "\"";
+      i++;
+    }
+  }
+  printf("uart_csv/uart_frame:%s\n", records.c_str());
+  uint32_t baud = FOSC / CLOCK_MODE / uart_bit;
+  expect((baud > UART_BAUD ? baud - UART_BAUD : UART_BAUD - baud) * 1000 <= UART_BAUD * UART_BAUD_TOLERANCE,
+         "bit time within UART_BAUD_TOLERANCE of UART_BAUD");
+  expect(queued == 6 && refused == 1, "a record that does not fit the ring buffer is refused whole");
+  expect(records == " \"t,0,1,-170\" \"t,1,1,177\" [type 01 00 FF 45 00 crc ok] \"t,1,1,177\" \"t,1,1,177\" "
+                    "\"t,1,1,177\"", "CSV lines and the binary frame arrive in order and complete");
+  write_vcd("uart.vcd", {{"txd", P3, 1}});
+}
+
+// Timer 2 in auto reload: counts up and reloads from RCAP2H:RCAP2L on overflow, setting TF2
+static void timer2_elapse(uint32_t cycles) {
+  uint32_t count = ((TH2 << 8) | TL2) + cycles;
+  while(count >= 0x10000) {
+    count = count - 0x10000 + ((RCAP2H << 8) | RCAP2L);
+    TF2 = 1;
+  }
+  TH2 = count >> 8;
+  TL2 = count & 0xFF;
+  sim_advance(cycles);
+}
+
+static void tf2_interrupt(void) {
+  TF2 = 0;
+  timebase_tick();
+}
+
+// Run to the next overflow and serve it
+static void timebase_next_tick(void) {
+  timer2_elapse(0x10000 - ((TH2 << 8) | TL2));
+  tf2_interrupt();
+}
+
+// Tasks report their run times by moving the Timer 2 count, the host timer does not count by itself
+static std::vector<uint16_t> sched_log;
+
+static void sched_fast(void) {
+  sched_log.push_back(sched_now());
+  timer2_elapse(120);
+}
+
+static void sched_slow(void) { // Runs across a tick, the interrupt waits for the task
+  timer2_elapse(TIMEBASE_CYCLES);
+}
+
+static uint8_t sched_once_runs;
+
+static void sched_once(void) {
+  timer2_elapse(40);
+  if(++sched_once_runs < 3)
+    sched_after(sched_once, 5);
+}
+
+static void trace_sched(void) {
+  sim_reset();
+  timebase_ticks = 0;
+  sched_init();
+  sched_log.clear();
+  sched_once_runs = 0;
+  uint8_t fast = sched_every(sched_fast, SCHED_MS(10));
+  uint8_t slow = sched_every(sched_slow, SCHED_MS(25));
+  uint8_t once = sched_after(sched_once, 3);
+  uint16_t idle = 0;
+  for(uint16_t tick = 0; tick < 100; tick++) {
+    timebase_next_tick();
+    if(tick >= 40 && tick < 65)
+      continue; // Main loop busy elsewhere, the periodic task has to catch up
+    uint8_t ran = 0;
+    while(sched_run()) {
+      ran = 1;
+      if(TF2) // Overflow during sched_slow, served once the task returned
+        tf2_interrupt();
+    }
+    idle += !ran;
+  }
+  printf("sched_run: fast at ticks");
+  for(uint16_t t : sched_log) {
+    printf(" %u", t);
+  }
+  printf(", worst fast %u slow %u once %u cycles (%u runs), %u idle ticks\n", sched_tasks[fast].worst,
+         sched_tasks[slow].worst, sched_tasks[once].worst, sched_once_runs, idle);
+  expect(sched_log == std::vector<uint16_t>{10, 20, 30, 40, 67, 68, 70, 80, 90, 100},
+         "periodic task every 10 ticks, catching up after a busy main loop without shifting its schedule");
+  expect(sched_tasks[fast].worst == 120 && sched_tasks[slow].worst == TIMEBASE_CYCLES &&
+         sched_tasks[once].worst == 40, "worst run times in machine cycles, also across a tick");
+  expect(sched_once_runs == 3, "one-shot task rescheduled by itself");
+}
+
+// Uptime read at odd points against the simulated cycle count, with overflows whose interrupt is held off
+static void trace_timebase(void) {
+  sim_reset();
+  timebase_ticks = 0;
+  timebase_init();
+  EA = 1;
+  uint32_t last = 0, worst = 0;
+  uint8_t monotonic = 1;
+  for(uint32_t i = 0; i < 30000; i++) {
+    timer2_elapse(337);
+    if(TF2 && i % 3) // Interrupt served, otherwise still pending while reading
+      tf2_interrupt();
+    uint32_t us = timebase_us();
+    double expected = (i + 1) * 337.0 * CLOCK_MODE * 1000000.0 / FOSC; // SFR accesses do not move the timer here
+    worst = std::max(worst, (uint32_t)std::abs(expected - us));
+    monotonic &= us >= last;
+    last = us;
+    if(TF2)
+      tf2_interrupt();
+  }
+  EA = 0;
+  uint32_t ms = timebase_ms();
+  printf("timebase_us: %u reads over %u ms, %s, off by %u us at most\n", 30000, ms,
+         monotonic ? "monotonic" : "NOT monotonic", worst);
+  expect(monotonic && worst <= 1, "timebase_us() follows the cycle count, also with an overflow pending");
+  expect(ms == (uint32_t)(30000 * 337.0 * CLOCK_MODE * 1000.0 / FOSC), "timebase_ms() counts whole ticks");
+}
+
+// Reload values computed at compile time against the period rounded to whole machine cycles
+static void trace_timer(void) {
+  sim_reset();
+  TMOD = 0x20; // Timer 1 as baud rate generator, kept by timer0_init()
+  timer0_init_us(1000);
+  uint32_t t0 = 0x10000UL - ((TH0.latch << 8) | TL0.latch);
+  TIMER1_RELOAD_US(10000);
+  uint32_t t1 = 0x10000UL - ((TH1.latch << 8) | TL1.latch);
+  uint32_t c0 = std::lround(1000e-6 * FOSC / CLOCK_MODE), c1 = std::lround(10000e-6 * FOSC / CLOCK_MODE);
+  printf("timer0_init_us(1000): %u cycles, TIMER1_RELOAD_US(10000): %u cycles, TMOD %02X\n", t0, t1, TMOD.latch);
+  expect(t0 == c0 && t1 == c1, "timer reloads count the period rounded to the nearest machine cycle");
+  expect(TMOD.latch == 0x21 && TR0 && !TF0, "timer0_init() starts Timer 0 in 16-bit mode, Timer 1 mode untouched");
+}
+
+// Idle mode lasts until the next Timer 2 overflow. Power-down records which external interrupts were armed and
+// wakes at once.
+static uint8_t power_armed;
+
+static void power_device(const sim_sfr &s) {
+  if(s.addr != PCON.addr)
+    return;
+  if(PCON.latch & IDL) {
+    timebase_next_tick();
+    PCON = PCON.latch & ~IDL; // Cleared by the wake-up
+  } else if(PCON.latch & PD) {
+    power_armed = (EX0 && IT0 ? POWER_WAKE_INT0 : 0) | (EX1 && IT1 ? POWER_WAKE_INT1 : 0);
+    PCON = PCON.latch & ~PD;
+  }
+}
+
+static void trace_power(void) {
+  sim_reset();
+  timebase_ticks = 0;
+  sched_init();
+  EA = 1;
+  sim_on_write = power_device;
+  power_idle_percent();
+  uint8_t task = sched_every(sched_fast, SCHED_MS(10)); // 120 cycles every 10ms
+  for(uint16_t i = 0; i < 2000; i++) {
+    if(!sched_run())
+      power_idle();
+  }
+  uint16_t ticks = sched_now() - power_window;
+  uint8_t idle = power_idle_percent();
+  sched_cancel(task);
+  EX0 = 0;
+  IT0 = 0;
+  EX1 = 1;
+  IT1 = 0;
+  power_armed = 0;
+  power_down(POWER_WAKE_INT0 | POWER_WAKE_INT1);
+  uint8_t armed = power_armed;
+  uint8_t restored = !EX0 && !IT0 && EX1 && !IT1;
+  sim_on_write = nullptr;
+  EA = 0;
+  EX1 = 0;
+  printf("power_idle: %u%% idle over %u ticks, power_down: wake %s%s, interrupt setup %s\n", idle, ticks,
+         armed & POWER_WAKE_INT0 ? "INT0 " : "", armed & POWER_WAKE_INT1 ? "INT1" : "",
+         restored ? "restored" : "NOT restored");
+  expect(idle >= 95, "idle between the task runs");
+  expect(armed == (POWER_WAKE_INT0 | POWER_WAKE_INT1) && restored,
+         "power_down() arms the requested wake-up interrupts and restores the previous setup");
+}
+
+int main(int argc, char **argv) {
+  if(argc > 1) {
+    vcd_dir = argv[1];
+  }
+  trace_st7920();
+  trace_st7920_fb();
+  trace_i2c();
+  trace_at24c02();
+  trace_wire();
+  trace_ds18b20();
+  trace_hd44780();
+  trace_hd44780_con();
+  trace_debounce();
+  trace_keypad();
+  trace_bcd();
+  trace_matrix();
+  trace_segment();
+  trace_nec();
+  trace_uart();
+  trace_timebase();
+  trace_timer();
+  trace_sched();
+  trace_power();
+  if(failures)
+    printf("%u checks failed\n", failures);
+  return failures ? 1 : 0;
+}
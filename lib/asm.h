@@ -0,0 +1,24 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file asm.h Helpers to reference C symbols from inline assembly.
+ * @author Thomas Reidemeister
+ */
+#ifndef ASM_H
+#define ASM_H
+
+// Assembler name of a pin or variable given as (macro for a) C identifier, e.g. ASM_SYM(ST7920_SID) is "_P2_5"
+#define ASM_STR(x) #x
+#define ASM_SYM(x) "_" ASM_STR(x)
+
+#endif // ASM_H
@@ -0,0 +1,74 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02.h AT24C02 256 byte I2C EEPROM.
+ * @author Thomas Reidemeister
+ */
+#ifndef AT24C02_H
+#define AT24C02_H
+
+#include <stdint.h>
+
+#include "i2c.h"
+
+#define AT24C02_ADDR      0xA0 // 7-bit address + Write bit
+#define AT24C02_PAGE_SIZE 8    // Bytes per write cycle, a page write wraps within its page
+#define AT24C02_T_WR      US_TO_CYCLES(5000) // Write cycle time (max)
+
+// Shortest address poll (START, address and ACK, STOP) from the bus delays alone, the bit-bang code adds to it
+#define AT24C02_POLL_CYCLES (I2C_T_SU_STA + I2C_T_HD_STA + 9 * (I2C_T_LOW + I2C_T_HIGH) + \
+                             I2C_T_LOW + I2C_T_SU_STO + I2C_T_BUF)
+// Address attempts covering the write cycle (49 at 100kHz, 148 at 400kHz with 12MHz 12T)
+#define AT24C02_POLLS       ((AT24C02_T_WR + AT24C02_POLL_CYCLES - 1) / AT24C02_POLL_CYCLES)
+
+/**
+ * Wait for the internal write cycle to finish by polling the device address until it is acknowledged.
+ * @return 1 when the device answered, 0 after AT24C02_POLLS attempts
+ */
+uint8_t at24c02_wait_ready(void);
+
+/**
+ * Write a single byte and wait for the write cycle.
+ * @param mem_addr Memory address
+ * @param data Byte to store
+ * @return 1 on success, 0 if the device did not acknowledge
+ */
+uint8_t at24c02_write_byte(uint8_t mem_addr, uint8_t data);
+
+/**
+ * Write a block, split into page writes at the 8-byte page boundaries (one write cycle per page).
+ * @param mem_addr Memory address of the first byte
+ * @param data Bytes to store
+ * @param len Number of bytes (up to 256)
+ * @return 1 on success, 0 if the device did not acknowledge
+ */
+uint8_t at24c02_write_page(uint8_t mem_addr, const uint8_t *data, uint16_t len);
+
+/**
+ * Read a block with one address phase (sequential read), the address wraps at the end of the memory.
+ * @param mem_addr Memory address of the first byte
+ * @param data Output buffer
+ * @param len Number of bytes (up to 256)
+ * @return 1 on success, 0 if the device did not acknowledge, on clock stretching timeout or for a zero length (no
+ * bus traffic)
+ */
+uint8_t at24c02_read_seq(uint8_t mem_addr, uint8_t *data, uint16_t len);
+
+/**
+ * Read a single byte (random read).
+ * @param mem_addr Memory address
+ * @return Stored byte, 0 on a clock stretching timeout during the read
+ */
+uint8_t at24c02_read_byte(uint8_t mem_addr);
+
+#endif // AT24C02_H
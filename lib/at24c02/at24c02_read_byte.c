@@ -0,0 +1,32 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02_read_byte.c AT24C02 random read.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "at24c02.h"
+#include "i2c.h"
+
+uint8_t at24c02_read_byte(uint8_t mem_addr) {
+  uint8_t data = 0;
+  i2c_start();
+  i2c_write(AT24C02_ADDR); // Device address + Write
+  i2c_write(mem_addr); // Memory address
+  i2c_start(); // Repeated start
+  i2c_write(AT24C02_ADDR | 0x01); // Device address + Read
+  i2c_read(&data, I2C_NACK); // Stays 0 on a clock stretching timeout
+  i2c_stop();
+  return data;
+}
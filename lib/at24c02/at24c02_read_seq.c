@@ -0,0 +1,40 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02_read_seq.c Sequential reads from the EEPROM.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "at24c02.h"
+#include "i2c.h"
+
+uint8_t at24c02_read_seq(uint8_t mem_addr, uint8_t *data, uint16_t len) {
+  if(!len) // A read ends with a NACKed byte, the loop below would wrap
+    return 0;
+  i2c_start();
+  uint8_t ack = i2c_write(AT24C02_ADDR) // Device address + Write
+      && i2c_write(mem_addr); // Memory address
+  if(ack) {
+    i2c_start(); // Repeated start
+    ack = i2c_write(AT24C02_ADDR | 0x01); // Device address + Read
+  }
+  while(ack && --len) {
+    ack = i2c_read(data++, I2C_ACK);
+  }
+  if(ack) {
+    ack = i2c_read(data, I2C_NACK); // Last byte
+  }
+  i2c_stop();
+  return ack;
+}
@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02_wait_ready.c Acknowledge polling for the end of the EEPROM write cycle.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "at24c02.h"
+#include "i2c.h"
+
+static_assert(AT24C02_POLLS <= 255, "AT24C02_POLLS exceeds the 8-bit poll counter");
+static_assert(AT24C02_POLLS * AT24C02_POLL_CYCLES >= AT24C02_T_WR, "AT24C02 polls end before the write cycle");
+
+uint8_t at24c02_wait_ready(void) {
+  for(uint8_t i = 0; i < AT24C02_POLLS; i++) {
+    if(i2c_write_buf(AT24C02_ADDR, 0, 0)) // The device ignores its address until the write cycle is done
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,25 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02_write_byte.c AT24C02 byte write.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "at24c02.h"
+#include "i2c.h"
+
+uint8_t at24c02_write_byte(uint8_t mem_addr, uint8_t data) {
+  uint8_t buf[2] = {mem_addr, data}; // Memory address, data byte
+  return i2c_write_buf(AT24C02_ADDR, buf, sizeof(buf)) && at24c02_wait_ready();
+}
@@ -0,0 +1,42 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file at24c02_write_page.c Page writes to the EEPROM.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "at24c02.h"
+#include "i2c.h"
+
+uint8_t at24c02_write_page(uint8_t mem_addr, const uint8_t *data, uint16_t len) {
+  while(len) {
+    // Bytes up to the end of the page, the address counter would wrap to the page start after that
+    uint8_t chunk = AT24C02_PAGE_SIZE - (mem_addr & (AT24C02_PAGE_SIZE - 1));
+    if(chunk > len) {
+      chunk = len;
+    }
+    i2c_start();
+    uint8_t ack = i2c_write(AT24C02_ADDR) && i2c_write(mem_addr); // Device address + Write, memory address
+    for(uint8_t i = 0; ack && i < chunk; i++) {
+      ack = i2c_write(data[i]);
+    }
+    i2c_stop();
+    if(!ack || !at24c02_wait_ready())
+      return 0;
+    mem_addr += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+  return 1;
+}
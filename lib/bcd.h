@@ -0,0 +1,52 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file bcd.h Binary to decimal conversion without division (double dabble).
+ * @author Thomas Reidemeister
+ */
+#ifndef BCD_H
+#define BCD_H
+
+#include <stdint.h>
+
+#define BCD_U8_DIGITS  3
+#define BCD_U16_DIGITS 5
+#define BCD_U32_DIGITS 10
+
+/*
+ * Shift-and-add-3: the value is shifted into a packed BCD accumulator MSB first, every nibble >= 5 gets 3 added
+ * before a shift so it carries into the next digit. Leading zero bits of the value are skipped.
+ */
+
+/**
+ * Convert to decimal digits.
+ * @param val Value
+ * @param digits Output, BCD_U8_DIGITS digits least significant first
+ */
+void bcd_u8(uint8_t val, uint8_t *digits);
+
+/**
+ * Convert to decimal digits.
+ * @param val Value
+ * @param digits Output, BCD_U16_DIGITS digits least significant first
+ */
+void bcd_u16(uint16_t val, uint8_t *digits);
+
+/**
+ * Convert to decimal digits.
+ * @param val Value
+ * @param digits Output, BCD_U32_DIGITS digits least significant first
+ */
+void bcd_u32(uint32_t val, uint8_t *digits);
+
+#endif // BCD_H
@@ -0,0 +1,44 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file bcd_u32.c Binary to decimal, 32-bit.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "bcd.h"
+
+void bcd_u32(uint32_t val, uint8_t *digits) {
+  uint8_t packed[5] = {0}; // Two digits per byte, least significant first
+  uint8_t i = 32;
+  while(i && !(val & 0x80000000UL)) { // Skip leading zero bits
+    val <<= 1;
+    i--;
+  }
+  for(; i; i--) {
+    uint8_t carry = (val & 0x80000000UL) != 0;
+    val <<= 1;
+    for(uint8_t j = 0; j < 5; j++) {
+      uint8_t b = packed[j];
+      if((b & 0x0F) >= 0x05)
+        b += 0x03;
+      if((b & 0xF0) >= 0x50)
+        b += 0x30;
+      packed[j] = (b << 1) | carry;
+      carry = b >> 7;
+    }
+  }
+  for(uint8_t j = 0; j < 10; j++) {
+    digits[j] = (j & 0x01) ? packed[j >> 1] >> 4 : packed[j >> 1] & 0x0F;
+  }
+}
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file bench.h Region markers for the simulator cycle benchmark (tools/bench.py).
+ * @author Thomas Reidemeister
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * Mark the start and end of a region to be timed by `ninja bench_<demo>`.
+ *
+ * The markers emit a global label only (no code), the benchmark picks them up
+ * from the linker map and reports the cycles between BENCH_BEGIN(name) and the
+ * following BENCH_END(name). Each name may only be used once per image.
+ */
+#define BENCH_BEGIN(name) __asm__("_bench_" #name "_begin::")
+#define BENCH_END(name)   __asm__("_bench_" #name "_end::")
+
+#endif // BENCH_H
@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file board.h Target clock configuration shared by the drivers.
+ * @author Thomas Reidemeister
+ */
+#ifndef BOARD_H
+#define BOARD_H
+
+// Overridden from meson.build (fosc, clock_mode)
+#ifndef FOSC
+#define FOSC 12000000UL // Crystal frequency in Hz
+#endif
+
+#ifndef CLOCK_MODE
+#define CLOCK_MODE 12 // Oscillator clocks per machine cycle (12T, or 6T when enabled with stcgal)
+#endif
+
+#endif // BOARD_H
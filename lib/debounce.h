@@ -0,0 +1,37 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file debounce.h Debouncing of eight inputs at once with vertical counters.
+ * @author Thomas Reidemeister
+ */
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+
+#define DEBOUNCE_HOLD_BITS  8   // Width of the vertical hold counter
+#define DEBOUNCE_LONG_TICKS 100 // Updates an input is held before it reports a long press (< 1 << DEBOUNCE_HOLD_BITS)
+
+extern uint8_t debounce_state;    // Debounced level, bit set while the input is active
+extern uint8_t debounce_pressed;  // Inputs that became active in the last update
+extern uint8_t debounce_released; // Inputs that became inactive in the last update
+extern uint8_t debounce_long;     // Inputs that reached DEBOUNCE_LONG_TICKS in the last update
+
+/**
+ * Feed one sample of eight inputs, call periodically from a timer interrupt (e.g. 10ms). An input changes state
+ * after 4 consecutive samples that differ from it. The edge masks are only valid until the next call.
+ * @param sample Raw inputs, bit set for active (e.g. ~P3 for buttons to ground)
+ */
+void debounce_update(uint8_t sample);
+
+#endif // DEBOUNCE_H
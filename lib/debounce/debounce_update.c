@@ -0,0 +1,50 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file debounce_update.c Vertical counter debouncing and long press detection.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "debounce.h"
+
+uint8_t debounce_state = 0;
+uint8_t debounce_pressed = 0;
+uint8_t debounce_released = 0;
+uint8_t debounce_long = 0;
+static uint8_t debounce_ct0 = 0xFF, debounce_ct1 = 0xFF; // Bit n of ct1:ct0 is the 2-bit counter of input n
+static uint8_t debounce_hold[DEBOUNCE_HOLD_BITS]; // Bit n of debounce_hold[k] is bit k of the hold time of input n
+static uint8_t debounce_held_long = 0; // Inputs past DEBOUNCE_LONG_TICKS
+
+void debounce_update(uint8_t sample) {
+  // Count down inputs that differ from the debounced state, reset all others
+  uint8_t delta = debounce_state ^ sample;
+  debounce_ct0 = ~(debounce_ct0 & delta);
+  debounce_ct1 = debounce_ct0 ^ (debounce_ct1 & delta);
+  delta &= debounce_ct0 & debounce_ct1; // Counter rolled over (4 samples)
+  debounce_state ^= delta;
+  debounce_pressed = debounce_state & delta;
+  debounce_released = ~debounce_state & delta;
+
+  // Advance the hold counter of active inputs, clear it for inactive ones
+  uint8_t carry = debounce_state & ~debounce_held_long;
+  uint8_t equal = debounce_state;
+  for(uint8_t k = 0; k < DEBOUNCE_HOLD_BITS; k++) {
+    uint8_t bit = debounce_hold[k] & debounce_state;
+    debounce_hold[k] = bit ^ carry;
+    carry &= bit;
+    equal &= (DEBOUNCE_LONG_TICKS >> k) & 1 ? debounce_hold[k] : ~debounce_hold[k];
+  }
+  debounce_long = equal & ~debounce_held_long;
+  debounce_held_long = (debounce_held_long | equal) & debounce_state;
+}
@@ -0,0 +1,90 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file delay.h Cycle-exact busy waits calibrated from FOSC and CLOCK_MODE.
+ * @author Thomas Reidemeister
+ */
+#ifndef DELAY_H
+#define DELAY_H
+
+#include <mcs51/compiler.h> // NOP
+#include <stdint.h>
+
+#include "board.h"
+
+/**
+ * Machine cycles for a duration in microseconds, rounded up so a wait never falls short of a datasheet minimum.
+ * FOSC / 100 keeps the common baud rate crystals (11.0592MHz, 22.1184MHz) exact in 32-bit arithmetic.
+ */
+#define US_TO_CYCLES(us) (((uint32_t)(us) * (FOSC / 100UL) + CLOCK_MODE * 10000UL - 1) / (CLOCK_MODE * 10000UL))
+
+/**
+ * Machine cycles for a duration in nanoseconds (up to 1ms), rounded up.
+ */
+#define NS_TO_CYCLES(ns) (((uint32_t)(ns) * (FOSC / 10000UL) + CLOCK_MODE * 100000UL - 1) / (CLOCK_MODE * 100000UL))
+
+// Cost of the loops including `mov dpl/dptr,#n`, `lcall` and `ret`
+#define DELAY_LOOP8_MIN     8UL      // delay_loop8(1)
+#define DELAY_LOOP8_MAX     516UL    // delay_loop8(255): 6 + 2 * n
+#define DELAY_CYCLES_MAX    131590UL // delay_loop16(0): 2 * L + 514 * H - 506 with L = H = 256
+
+// Split a cycle count into the inner (L) and outer (H) counts of delay_loop16, at most 3 cycles long
+#define DELAY_LOOP16_H(c) (((uint32_t)(c) + 507UL) / 514UL)
+#define DELAY_LOOP16_L(c) (((uint32_t)(c) + 506UL > 514UL * DELAY_LOOP16_H(c)) ? \
+    (((uint32_t)(c) + 507UL - 514UL * DELAY_LOOP16_H(c)) / 2UL) : 1UL)
+#define DELAY_LOOP16_ARG(c) ((uint16_t)(((DELAY_LOOP16_H(c) & 0xFF) << 8) | (DELAY_LOOP16_L(c) & 0xFF)))
+
+/**
+ * Busy wait for a compile time constant number of machine cycles.
+ *
+ * Up to 7 cycles are NOPs, longer waits use a DJNZ loop. The result is exact or at most 3 cycles long and does not
+ * include time spent in interrupt handlers.
+ */
+#define delay_cycles(c) do { \
+    static_assert((c) <= DELAY_CYCLES_MAX, "delay too long, use delay_ms()"); \
+    if((c) >= DELAY_LOOP8_MIN && (c) <= DELAY_LOOP8_MAX) { \
+      delay_loop8((uint8_t)(((c) - 5UL) / 2UL)); \
+    } else if((c) > DELAY_LOOP8_MAX) { \
+      delay_loop16(DELAY_LOOP16_ARG(c)); \
+    } else { \
+      if((c) & 1) { NOP(); } \
+      if((c) & 2) { NOP(); NOP(); } \
+      if((c) & 4) { NOP(); NOP(); NOP(); NOP(); } \
+    } \
+  } while(0)
+
+/**
+ * Busy wait for at least the given time.
+ * @param us Microseconds, compile time constant
+ */
+#define delay_us(us) delay_cycles(US_TO_CYCLES(us))
+
+/**
+ * DJNZ loop of 2 cycles per iteration, use delay_cycles().
+ * @param n Iterations (0 = 256)
+ */
+void delay_loop8(uint8_t n);
+
+/**
+ * Nested DJNZ loop, use delay_cycles().
+ * @param n Outer count in the high byte, inner count of the first pass in the low byte (0 = 256)
+ */
+void delay_loop16(uint16_t n);
+
+/**
+ * Busy wait for at least the given time.
+ * @param ms Milliseconds
+ */
+void delay_ms(uint16_t ms);
+
+#endif // DELAY_H
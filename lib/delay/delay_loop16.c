@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file delay_loop16.c 16-bit nested DJNZ delay loop.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "delay.h"
+
+void delay_loop16(uint16_t n) __naked {
+  (void)n; // Passed in DPH:DPL
+  __asm__(
+    "00001$:\n"
+    "\tdjnz\tdpl,00001$\t; 2 cycles, 256 per pass after the first\n"
+    "\tdjnz\tdph,00001$\t; 2 cycles\n"
+    "\tret\n");
+}
@@ -0,0 +1,27 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file delay_ms.c Millisecond busy wait.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "delay.h"
+
+#define DELAY_MS_LOOP_CYCLES 8 // while(ms--) bookkeeping per iteration
+
+void delay_ms(uint16_t ms) {
+  while(ms--) {
+    delay_cycles(US_TO_CYCLES(1000) - DELAY_MS_LOOP_CYCLES);
+  }
+}
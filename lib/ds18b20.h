@@ -0,0 +1,116 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20.h DS18B20 temperature sensors (one or more devices on the bus).
+ * @author Thomas Reidemeister
+ */
+#ifndef DS18B20_H
+#define DS18B20_H
+
+#include <stdint.h>
+
+#include "wire.h"
+
+#define DS18B20_FAMILY      0x28 // First ROM byte
+#define DS18B20_MAX_DEVICES 8
+#define DS18B20_CONVERT_T   0x44
+#define DS18B20_READ_SCRATCHPAD 0xBE
+#define DS18B20_WRITE_SCRATCHPAD 0x4E
+#define DS18B20_SCRATCHPAD_SIZE 9 // Temperature (2), TH, TL, config, reserved (3), CRC
+#define DS18B20_CONFIG      4    // Scratchpad byte holding the resolution in bits 5-6
+
+/**
+ * Maximum conversion time of a resolution (datasheet: 93.75, 187.5, 375, 750ms).
+ * @param bits 9-12
+ */
+#define DS18B20_CONVERT_MS(bits) ((750U + (1U << (12 - (bits))) - 1) >> (12 - (bits)))
+
+#ifndef DS18B20_MEM
+#define DS18B20_MEM __xdata
+#endif
+
+enum ds18b20_state {
+  DS18B20_IDLE,    // Nothing to do, ds18b20_start() begins a round
+  DS18B20_CONVERT, // Broadcast Convert T
+  DS18B20_WAIT,    // Conversion running, poll the ready flag until the tick budget runs out
+  DS18B20_READ,    // Read one device per step
+};
+
+extern DS18B20_MEM uint8_t ds18b20_rom[DS18B20_MAX_DEVICES][WIRE_ROM_SIZE]; // Device table filled by ds18b20_scan()
+extern uint8_t ds18b20_count; // Devices in ds18b20_rom
+extern int16_t ds18b20_temp[DS18B20_MAX_DEVICES]; // Last round, temperature in 1/16 degrees C
+extern uint8_t ds18b20_valid; // Bit i set if ds18b20_temp[i] was read with a good CRC
+extern enum ds18b20_state ds18b20_state;
+extern volatile uint16_t ds18b20_ticks; // Conversion budget left, counted down by ds18b20_tick()
+
+/**
+ * Enumerate the DS18B20 on the bus with the ROM search into ds18b20_rom.
+ * @return Number of devices found (at most DS18B20_MAX_DEVICES)
+ */
+uint8_t ds18b20_scan(void);
+
+/**
+ * Start a temperature conversion on all devices at once (Skip ROM, takes up to 750ms at 12-bit resolution).
+ * @return 1 if a device answered the reset, 0 otherwise
+ */
+uint8_t ds18b20_start_conversion(void);
+
+/**
+ * Read the last conversion result of a single device on the bus from the scratchpad (Skip ROM, no CRC check).
+ * @return Temperature in 1/16 degrees C
+ */
+int16_t ds18b20_read_temperature(void);
+
+/**
+ * Read the scratchpad of a device from the table and verify its CRC.
+ * @param index Device in ds18b20_rom
+ * @param raw Output, temperature in 1/16 degrees C
+ * @return 1 on success, 0 on missing presence or CRC mismatch
+ */
+uint8_t ds18b20_read(uint8_t index, int16_t *raw);
+
+/**
+ * Begin a conversion round of all devices in the table, stepped by ds18b20_poll().
+ * @param timeout Conversion budget in ds18b20_tick() calls, used if the ready flag is not seen (parasite power)
+ */
+void ds18b20_start(uint16_t timeout);
+
+/**
+ * Advance the conversion round by one step, call from the main loop.
+ * Each step is a short bus transaction (at most one device read, ~11ms), nothing blocks while converting.
+ * @return 1 when the round finished and ds18b20_temp/ds18b20_valid are updated, 0 otherwise
+ */
+uint8_t ds18b20_poll(void);
+
+/**
+ * Count down the conversion budget, call periodically from a timer interrupt.
+ */
+void ds18b20_tick(void);
+
+/**
+ * Set the resolution of all devices on the bus (Skip ROM, scratchpad only, lost on power cycle).
+ * The alarm registers TH/TL are set back to their factory values.
+ * @param bits 9 (0.5C, 94ms) to 12 (0.0625C, 750ms), other values are clamped to that range
+ * @return 1 if a device answered the reset, 0 otherwise
+ */
+uint8_t ds18b20_set_resolution(uint8_t bits);
+
+/**
+ * Convert a raw reading to decimal digits with shifts and adds only (no multiply or divide).
+ * @param raw Temperature in 1/16 degrees C (-55 to 125C)
+ * @param bcd Output, 4 digits least significant first: tenths, ones, tens, hundreds (tenths rounded)
+ * @return 1 if the temperature is negative (digits hold the magnitude), 0 otherwise
+ */
+uint8_t ds18b20_to_bcd(int16_t raw, uint8_t *bcd);
+
+#endif // DS18B20_H
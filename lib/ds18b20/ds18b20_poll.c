@@ -0,0 +1,67 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_poll.c Non-blocking DS18B20 conversion round.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+#include "wire.h"
+
+int16_t ds18b20_temp[DS18B20_MAX_DEVICES];
+uint8_t ds18b20_valid = 0;
+enum ds18b20_state ds18b20_state = DS18B20_IDLE;
+volatile uint16_t ds18b20_ticks = 0;
+static uint8_t ds18b20_next;         // Device read in the next step
+
+uint8_t ds18b20_poll(void) {
+  switch(ds18b20_state) {
+  case DS18B20_CONVERT:
+    ds18b20_state = ds18b20_start_conversion() ? DS18B20_WAIT : DS18B20_IDLE;
+    ds18b20_next = 0;
+    if(ds18b20_state == DS18B20_IDLE) {
+      ds18b20_valid = 0; // Nobody on the bus
+      return 1;
+    }
+    break;
+  case DS18B20_WAIT: {
+    __bit ea = EA;
+    EA = 0; // 16-bit counter shared with the interrupt
+    uint8_t expired = ds18b20_ticks == 0;
+    EA = ea;
+    if(expired || wire_read_bit()) // Devices hold read slots low while converting
+      ds18b20_state = DS18B20_READ;
+    break;
+  }
+  case DS18B20_READ:
+    if(ds18b20_next < ds18b20_count) {
+      uint8_t mask = 1 << ds18b20_next;
+      if(ds18b20_read(ds18b20_next, &ds18b20_temp[ds18b20_next])) {
+        ds18b20_valid |= mask;
+      } else {
+        ds18b20_valid &= ~mask;
+      }
+      ds18b20_next++;
+    }
+    if(ds18b20_next >= ds18b20_count) {
+      ds18b20_state = DS18B20_IDLE;
+      return 1;
+    }
+    break;
+  default:
+    break;
+  }
+  return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_read.c Read and verify the scratchpad of one DS18B20.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+#include "wire.h"
+
+uint8_t ds18b20_read(uint8_t index, int16_t *raw) {
+  uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+  if(!wire_init())
+    return 0;
+  wire_select(ds18b20_rom[index]); // Match ROM
+  wire_write_byte(DS18B20_READ_SCRATCHPAD);
+  for(uint8_t i = 0; i < DS18B20_SCRATCHPAD_SIZE; i++) {
+    scratchpad[i] = wire_read_byte();
+  }
+  if(wire_crc8(scratchpad, DS18B20_SCRATCHPAD_SIZE))
+    return 0;
+  uint8_t config = scratchpad[DS18B20_CONFIG];
+  if((config & 0x1F) != 0x1F) // Config register reserved bits read 1, all zeros (bus stuck low) passes the CRC
+    return 0;
+  // Bits below the configured resolution are undefined
+  // MSB shifted as uint16_t, the 16-bit int of SDCC overflows for negative temperatures
+  *raw = (scratchpad[0] | ((uint16_t)scratchpad[1] << 8)) & (0xFFFFU << (3 - ((config >> 5) & 0x03)));
+  return 1;
+}
@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_read_temperature.c DS18B20 scratchpad read.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+#include "wire.h"
+
+int16_t ds18b20_read_temperature(void) {
+  uint16_t temp = 0;
+  wire_init();
+  wire_select(0); // Skip ROM (only thing connected to P3_7)
+  wire_write_byte(DS18B20_READ_SCRATCHPAD);
+  temp = wire_read_byte();
+  temp |= wire_read_byte() << 8;
+  return temp;
+}
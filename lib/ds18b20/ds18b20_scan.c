@@ -0,0 +1,41 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_scan.c Enumerate the DS18B20 on the bus.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+#include "wire.h"
+
+DS18B20_MEM uint8_t ds18b20_rom[DS18B20_MAX_DEVICES][WIRE_ROM_SIZE];
+uint8_t ds18b20_count = 0;
+
+uint8_t ds18b20_scan(void) {
+  uint8_t rom[WIRE_ROM_SIZE];
+  uint8_t last_discrepancy = 0;
+  ds18b20_count = 0;
+  do {
+    if(!wire_search(rom, &last_discrepancy))
+      break;
+    if(rom[0] != DS18B20_FAMILY)
+      continue; // Other 1-Wire device on the bus
+    for(uint8_t i = 0; i < WIRE_ROM_SIZE; i++) {
+      ds18b20_rom[ds18b20_count][i] = rom[i];
+    }
+    ds18b20_count++;
+  } while(last_discrepancy && ds18b20_count < DS18B20_MAX_DEVICES);
+  return ds18b20_count;
+}
@@ -0,0 +1,36 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_set_resolution.c DS18B20 resolution configuration.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+#include "wire.h"
+
+uint8_t ds18b20_set_resolution(uint8_t bits) {
+  if(bits < 9) // R1 R0 only encode 9 to 12 bits
+    bits = 9;
+  else if(bits > 12)
+    bits = 12;
+  if(!wire_init())
+    return 0;
+  wire_select(0); // Skip ROM, same resolution on all devices
+  wire_write_byte(DS18B20_WRITE_SCRATCHPAD);
+  wire_write_byte(0x4B); // TH (factory default 75C)
+  wire_write_byte(0x46); // TL (factory default 70C)
+  wire_write_byte(((bits - 9) << 5) | 0x1F); // R1 R0 in bits 6-5, reserved bits read 1
+  return 1;
+}
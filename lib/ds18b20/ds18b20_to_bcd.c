@@ -0,0 +1,43 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ds18b20_to_bcd.c DS18B20 fixed-point to decimal conversion.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "ds18b20.h"
+
+uint8_t ds18b20_to_bcd(int16_t raw, uint8_t *bcd) {
+  uint8_t negative = raw < 0;
+  uint16_t mag = negative ? -raw : raw;
+  uint8_t frac = mag & 0x0F;
+  bcd[0] = ((frac << 3) + (frac << 1) + 8) >> 4; // frac * 10 / 16 rounded, at most 9
+
+  // Double dabble the integer part (0-125) into three BCD digits
+  uint8_t whole = mag >> 4;
+  uint16_t digits = 0;
+  for(uint8_t i = 0; i < 7; i++) {
+    if((digits & 0x0F) >= 0x05)
+      digits += 0x03;
+    if((digits & 0xF0) >= 0x50)
+      digits += 0x30;
+    digits = (digits << 1) | ((whole >> 6) & 0x01);
+    whole <<= 1;
+  }
+  bcd[1] = digits & 0x0F;
+  bcd[2] = (digits >> 4) & 0x0F;
+  bcd[3] = digits >> 8;
+  return negative;
+}
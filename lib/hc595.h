@@ -0,0 +1,32 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hc595.h 74HC595 shift register (LED array and matrix row driver).
+ * @author Thomas Reidemeister
+ */
+#ifndef HC595_H
+#define HC595_H
+
+#include <stdint.h>
+
+#define HC595_SRCLK P3_6
+#define HC595_RCLK  P3_5
+#define HC595_SER   P3_4
+
+/**
+ * Shift a byte MSB first into the 74HC595 and latch it to the outputs.
+ * @param value Output pattern
+ */
+void HC575_write(uint8_t value);
+
+#endif // HC595_H
@@ -0,0 +1,66 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hc575_write.c 74HC595 shift register output.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <mcs51/compiler.h> // NOP
+#include <stdint.h>
+
+#include "asm.h"
+#include "hc595.h"
+
+// Called from matrix_scan() in the timer interrupt, keep the parameter out of the overlay segment
+#pragma save
+#pragma nooverlay
+
+#ifdef HAL_ASM_KERNELS
+// One bit: MSB into carry, carry to SER, SRCLK pulse (5 cycles, the pulse is 1us at 12MHz)
+#define HC595_BIT \
+    "\trlc\ta\n" \
+    "\tmov\t" ASM_SYM(HC595_SER) ",c\n" \
+    "\tsetb\t" ASM_SYM(HC595_SRCLK) "\n" \
+    "\tclr\t" ASM_SYM(HC595_SRCLK) "\n"
+
+void HC575_write(uint8_t value) __naked { // 47 cycles including ret
+  (void)value; // Passed in DPL
+  __asm__(
+    "\tmov\ta,dpl\n"
+    "\tclr\t" ASM_SYM(HC595_SRCLK) "\n"
+    "\tclr\t" ASM_SYM(HC595_RCLK) "\n"
+    HC595_BIT HC595_BIT HC595_BIT HC595_BIT HC595_BIT HC595_BIT HC595_BIT HC595_BIT
+    "\tsetb\t" ASM_SYM(HC595_RCLK) "\n" // Latch outputs
+    "\tclr\t" ASM_SYM(HC595_RCLK) "\n"
+    "\tret\n");
+}
+#else
+void HC575_write(uint8_t value) {
+  HC595_SRCLK=0;
+  HC595_RCLK=0;
+  for(uint8_t i=0; i<8; i++) {
+    HC595_SER = value >> 7;
+    value <<= 1;
+    HC595_SRCLK = 1;
+    NOP();
+    NOP();
+    HC595_SRCLK = 0;
+  }
+  HC595_RCLK = 1;
+  NOP();
+  NOP();
+  HC595_RCLK = 0;
+}
+#endif
+
+#pragma restore
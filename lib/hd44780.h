@@ -0,0 +1,113 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780.h HD44780 character LCD with an 8-bit or 4-bit (HD44780_4BIT) interface.
+ * @author Thomas Reidemeister
+ */
+#ifndef HD44780_H
+#define HD44780_H
+
+#include <stdint.h>
+
+#define HD44780_E  P2_7
+#define HD44780_RS P2_6
+#define HD44780_RW P2_5
+#define HD44780_DATA P0
+
+/*
+ * Build options (see meson_options.txt):
+ *  HD44780_4BIT          D4-D7 on P0_4..P0_7 only, P0_0..P0_3 are left to the application
+ *  HD44780_NO_BUSY_FLAG  RW tied low, wait the worst case instruction time instead of polling the busy flag
+ */
+#ifdef HD44780_4BIT
+#define HD44780_DATA_MASK 0xF0
+#else
+#define HD44780_DATA_MASK 0xFF
+#endif
+#define HD44780_BUSY_FLAG   0x80
+#define HD44780_BUSY_POLLS  2000 // Give up on a missing display after ~20ms
+
+#define HD44780_FUNC_SET        0x30
+#define HD44780_DISP_CLEAR      0x01
+#define HD44780_DISP_OFF        0x08
+#define HD44780_DISP_ON         0x0C
+#define HD44780_CURSOR_ON       0x0E
+#define HD44780_CURSOR_OFF      0x0C
+#define HD44780_CURSOR_BLINK    0x0F
+#define HD44780_RETURN_HOME     0x02
+#define HD44780_ENTRY_MODE      0x06
+#define HD44780_2_ROWS          0x08
+#define HD44780_POSITION        0x80
+#define HD44780_ROW2_START      0x40
+#define HD44780_CGRAM_ADDR      0x40
+#define HD44780_DRAM_ADDR       0x80
+#define HD44780_8BIT            0x10 // Interface length bit of HD44780_FUNC_SET
+#ifdef HD44780_4BIT
+#define HD44780_FUNC_MODE       (HD44780_FUNC_SET & ~HD44780_8BIT)
+#else
+#define HD44780_FUNC_MODE       HD44780_FUNC_SET
+#endif
+
+#ifdef HD44780_NO_BUSY_FLAG
+extern __bit hd44780_slow; // Last instruction was clear display or return home, set by hd44780_command()
+#endif
+
+/**
+ * Put D7..D4 (all of D7..D0 in 8-bit mode) on the bus and strobe E once.
+ * @param d Bits to write
+ */
+void hd44780_strobe(uint8_t d);
+
+/**
+ * Put a byte on the bus, one strobe in 8-bit mode, high then low nibble in 4-bit mode.
+ * @param d Byte to write
+ */
+void hd44780_byte(uint8_t d);
+
+/**
+ * Wait until the controller can take the next instruction (busy flag, RS=0 RW=1).
+ * Returns as soon as the flag clears, after HD44780_BUSY_POLLS polls at most.
+ */
+void hd44780_wait(void);
+
+/**
+ * Wait for the previous instruction and send an instruction (RS=0).
+ * @param cmd Instruction byte
+ */
+void hd44780_command(uint8_t cmd);
+
+/**
+ * Wait for the previous instruction and write a byte to DDRAM/CGRAM (RS=1).
+ * @param data Data byte
+ */
+void hd44780_data(uint8_t data);
+
+/**
+ * Write a zero terminated string at the current cursor position.
+ * @param str Text
+ */
+void hd44780_text(const char* str);
+
+/**
+ * Initialization by instruction (display left off).
+ */
+void hd44780_init(void);
+
+/**
+ * Define a custom character.
+ * @param location Character code 0-7
+ * @param charmap 8 rows of 5 pixels
+ */
+void hd44780_custom_char(uint8_t location, const uint8_t* charmap);
+
+#endif // HD44780_H
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_command.c HD44780 instruction write.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "hd44780.h"
+
+void hd44780_command(uint8_t cmd) {
+  hd44780_wait();
+  HD44780_RS = 0; // Command mode
+  HD44780_RW = 0; // Write mode
+  hd44780_byte(cmd);
+#ifdef HD44780_NO_BUSY_FLAG
+  hd44780_slow = cmd <= (HD44780_RETURN_HOME | 0x01);
+#endif
+}
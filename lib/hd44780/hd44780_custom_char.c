@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_custom_char.c HD44780 CGRAM upload.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "hd44780.h"
+
+void hd44780_custom_char(uint8_t location, const uint8_t* charmap) {
+  location &= 0x7; // We only have 8 locations 0-7
+  hd44780_command(HD44780_CGRAM_ADDR | (location << 3)); // each location takes 8 bytes
+  for (uint8_t i = 0; i < 8; i++) {
+    hd44780_data(charmap[i]);
+  }
+  // Return to DDRAM
+  hd44780_command(HD44780_DRAM_ADDR);
+}
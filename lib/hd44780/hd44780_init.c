@@ -0,0 +1,44 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_init.c HD44780 initialization.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "hd44780.h"
+
+void hd44780_init(void) { // Figure 23/24 from HD44780 datasheet
+  delay_ms(15); // Wait for more than 15ms after Vcc rises to 4.5V
+
+  // Busy flag can not be checked yet, 8-bit function set (single strobe in either mode)
+  HD44780_RS = 0;
+  HD44780_RW = 0;
+  hd44780_strobe(HD44780_FUNC_SET);
+  delay_us(4100); // Wait for more than 4.1ms
+  hd44780_strobe(HD44780_FUNC_SET);
+  delay_us(100); // Wait for more than 100us
+  hd44780_strobe(HD44780_FUNC_SET);
+  delay_us(37);
+#ifdef HD44780_4BIT
+  hd44780_strobe(HD44780_FUNC_MODE); // Switch to 4-bit, following instructions take two strobes
+  delay_us(37);
+#endif
+
+  hd44780_command(HD44780_FUNC_MODE | HD44780_2_ROWS);
+  hd44780_command(HD44780_DISP_OFF);
+  hd44780_command(HD44780_DISP_CLEAR);
+  hd44780_command(HD44780_ENTRY_MODE);
+}
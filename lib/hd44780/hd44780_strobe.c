@@ -0,0 +1,34 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_strobe.c HD44780 single enable strobe.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "hd44780.h"
+
+void hd44780_strobe(uint8_t d) {
+  HD44780_E = 1;
+#ifdef HD44780_4BIT
+  HD44780_DATA &= ~HD44780_DATA_MASK; // ANL/ORL on the latch, P0_0..P0_3 keep their state
+  HD44780_DATA |= d & HD44780_DATA_MASK;
+#else
+  HD44780_DATA = d;
+#endif
+  delay_us(1); // Enable pulse width (more than 450ns)
+  HD44780_E = 0;
+  delay_us(1); // Enable cycle time (more than 1000ns)
+}
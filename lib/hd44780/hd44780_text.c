@@ -0,0 +1,26 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_text.c HD44780 text output.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "hd44780.h"
+
+void hd44780_text(const char* str) {
+  while (*str) {
+    hd44780_data((uint8_t)(*str));
+    str++;
+  }
+}
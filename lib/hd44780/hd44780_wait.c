@@ -0,0 +1,56 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_wait.c HD44780 busy flag polling.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "hd44780.h"
+
+#ifdef HD44780_NO_BUSY_FLAG
+__bit hd44780_slow = 0; // Last instruction was clear display or return home
+#endif
+
+void hd44780_wait(void) {
+#ifdef HD44780_NO_BUSY_FLAG
+  if(hd44780_slow) {
+    delay_us(1520); // Clear display and return home take 1.52ms
+    hd44780_slow = 0;
+  } else {
+    delay_us(37); // Everything else 37us
+  }
+#else
+  HD44780_DATA |= HD44780_DATA_MASK; // Release the data lines so the controller can drive them
+  HD44780_RS = 0;
+  HD44780_RW = 1; // Read busy flag and address counter
+  for(uint16_t i = 0; i < HD44780_BUSY_POLLS; i++) {
+    HD44780_E = 1;
+    delay_us(1); // Data valid 360ns after E rises
+    uint8_t busy = HD44780_DATA & HD44780_BUSY_FLAG;
+    HD44780_E = 0;
+#ifdef HD44780_4BIT
+    delay_us(1);
+    HD44780_E = 1; // Low nibble of the address counter, not needed
+    delay_us(1);
+    HD44780_E = 0;
+#endif
+    if(!busy)
+      break;
+    delay_us(1); // Enable cycle time
+  }
+  HD44780_RW = 0;
+#endif
+}
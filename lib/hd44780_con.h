@@ -0,0 +1,83 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_con.h Shadow text buffer for HD44780 character displays, flushed as differences.
+ * @author Thomas Reidemeister
+ */
+#ifndef HD44780_CON_H
+#define HD44780_CON_H
+
+#include <stdint.h>
+
+#include "hd44780.h"
+
+#define HD44780_CON_ROWS 2
+#define HD44780_CON_COLS 16
+#define HD44780_CON_SIZE (HD44780_CON_ROWS * HD44780_CON_COLS)
+
+// Memory space of the two 32 byte buffers
+#ifndef HD44780_CON_MEM
+#define HD44780_CON_MEM __xdata
+#endif
+
+extern HD44780_CON_MEM char hd44780_con[HD44780_CON_SIZE];       // Text to show, row after row
+extern HD44780_CON_MEM char hd44780_con_shown[HD44780_CON_SIZE]; // Text on the display after the last flush
+extern uint8_t hd44780_con_pos; // Write position in hd44780_con
+
+/**
+ * Move the write position.
+ * @param row 0-1
+ * @param col 0-15
+ */
+#define hd44780_con_goto(row, col) (hd44780_con_pos = (row) * HD44780_CON_COLS + (col))
+
+/**
+ * Mark the whole display as changed, e.g. after hd44780_init() or a HD44780_DISP_CLEAR.
+ */
+void hd44780_con_invalidate(void);
+
+/**
+ * Fill the buffer with spaces and move to the top left.
+ */
+void hd44780_con_clear(void);
+
+/**
+ * Write a character at the write position and advance it, wrapping from the end of a row to the next.
+ * '\n' blanks the rest of the row and moves to the start of the next one (no effect at the start of a row).
+ * @param c Character (0-7 for the custom characters)
+ */
+void hd44780_con_putc(char c);
+
+/**
+ * Write a zero terminated string, see hd44780_con_putc().
+ * @param str Text
+ */
+void hd44780_con_puts(const char *str);
+
+/**
+ * Formatted write into the buffer.
+ * Supports %c %s %d %u %x %X %%, the 'l' length modifier (long) and a field width with optional '0' padding,
+ * e.g. "%5u" or "%08lX". Numbers are converted without division (lib/bcd.h).
+ * Pass 8-bit values cast to int, SDCC does not promote char arguments of variadic functions.
+ * @param fmt Format
+ */
+void hd44780_con_printf(const char *fmt, ...);
+
+/**
+ * Send the characters that differ from hd44780_con_shown, a cursor move is only emitted where the changed
+ * characters are not consecutive.
+ * @return Number of bytes sent (commands and data)
+ */
+uint8_t hd44780_con_flush(void);
+
+#endif // HD44780_CON_H
@@ -0,0 +1,42 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_con_flush.c HD44780 console difference flush.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "hd44780_con.h"
+
+uint8_t hd44780_con_flush(void) {
+  uint8_t sent = 0;
+  uint8_t cursor = 0xFF; // Position the display's address counter points at, unknown
+  for(uint8_t i = 0; i < HD44780_CON_SIZE; i++) {
+    char c = hd44780_con[i];
+    if(c == hd44780_con_shown[i])
+      continue;
+    if(cursor != i) { // DDRAM rows start at 0x00 and 0x40
+      uint8_t row = i < HD44780_CON_COLS ? 0 : HD44780_ROW2_START;
+      hd44780_command(HD44780_POSITION | row | (i % HD44780_CON_COLS));
+      sent++;
+    }
+    hd44780_data(c);
+    hd44780_con_shown[i] = c;
+    sent++;
+    cursor = i + 1;
+    if(cursor == HD44780_CON_COLS)
+      cursor = 0xFF; // Address counter continues at 0x10, not on the second row
+  }
+  return sent;
+}
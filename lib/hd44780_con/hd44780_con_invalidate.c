@@ -0,0 +1,25 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_con_invalidate.c Force a full redraw on the next HD44780 console flush.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "hd44780_con.h"
+
+void hd44780_con_invalidate(void) {
+  for(uint8_t i = 0; i < HD44780_CON_SIZE; i++) {
+    hd44780_con_shown[i] = ~hd44780_con[i];
+  }
+}
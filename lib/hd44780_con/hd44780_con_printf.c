@@ -0,0 +1,128 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_con_printf.c HD44780 console formatted output.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "bcd.h"
+#include "hd44780_con.h"
+
+// Emit digits (most significant first) right aligned in a field
+static void con_field(const char *digits, uint8_t len, uint8_t negative, uint8_t width, char pad) {
+  uint8_t used = len + negative;
+  if(negative && pad == '0')
+    hd44780_con_putc('-'); // Sign goes before zero padding
+  for(; width > used; width--) {
+    hd44780_con_putc(pad);
+  }
+  if(negative && pad != '0')
+    hd44780_con_putc('-');
+  while(len--) {
+    hd44780_con_putc(*digits++);
+  }
+}
+
+void hd44780_con_printf(const char *fmt, ...) {
+  va_list ap;
+  char text[BCD_U32_DIGITS];
+  uint8_t bcd[BCD_U32_DIGITS];
+  va_start(ap, fmt);
+  for(; *fmt; fmt++) {
+    if(*fmt != '%') {
+      hd44780_con_putc(*fmt);
+      continue;
+    }
+    char pad = ' ';
+    uint8_t width = 0;
+    uint8_t is_long = 0;
+    if(*++fmt == '0') {
+      pad = '0';
+      fmt++;
+    }
+    while(*fmt >= '0' && *fmt <= '9') {
+      width = width * 10 + (*fmt++ - '0');
+    }
+    if(*fmt == 'l') {
+      is_long = 1;
+      fmt++;
+    }
+    uint32_t val;
+    uint8_t negative = 0;
+    switch(*fmt) {
+    case 'c':
+      hd44780_con_putc((char)va_arg(ap, int));
+      continue;
+    case 's': {
+      const char *str = va_arg(ap, const char *);
+      uint8_t len = 0;
+      while(str[len])
+        len++;
+      con_field(str, len, 0, width, ' ');
+      continue;
+    }
+    case 'd':
+      if(is_long) {
+        int32_t v = va_arg(ap, int32_t);
+        negative = v < 0;
+        val = negative ? 0 - (uint32_t)v : (uint32_t)v;
+      } else {
+        int v = va_arg(ap, int);
+        negative = v < 0;
+        val = negative ? 0 - (unsigned int)v : (unsigned int)v;
+      }
+      break;
+    case 'u':
+    case 'x':
+    case 'X':
+      val = is_long ? va_arg(ap, uint32_t) : va_arg(ap, unsigned int);
+      break;
+    case '\0':
+      fmt--; // Stray '%' at the end
+      continue;
+    default: // %% and unknown conversions print the character
+      hd44780_con_putc(*fmt);
+      continue;
+    }
+
+    uint8_t len = 0;
+    if(*fmt == 'x' || *fmt == 'X') {
+      const char *hex = *fmt == 'x' ? "0123456789abcdef" : "0123456789ABCDEF";
+      do {
+        bcd[len++] = hex[val & 0x0F];
+        val >>= 4;
+      } while(val);
+    } else {
+      if(is_long) { // Digits least significant first
+        bcd_u32(val, bcd);
+        len = BCD_U32_DIGITS;
+      } else {
+        bcd_u16(val, bcd);
+        len = BCD_U16_DIGITS;
+      }
+      while(len > 1 && !bcd[len - 1])
+        len--;
+      for(uint8_t i = 0; i < len; i++) {
+        bcd[i] += '0';
+      }
+    }
+    for(uint8_t i = 0; i < len; i++) {
+      text[i] = bcd[len - 1 - i];
+    }
+    con_field(text, len, negative, width, pad);
+  }
+  va_end(ap);
+}
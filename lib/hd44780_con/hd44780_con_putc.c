@@ -0,0 +1,32 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file hd44780_con_putc.c HD44780 console character output.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "hd44780_con.h"
+
+void hd44780_con_putc(char c) {
+  if(c == '\n') {
+    while(hd44780_con_pos % HD44780_CON_COLS) { // Nothing to do at a row start (a full row already wrapped)
+      hd44780_con[hd44780_con_pos++] = ' ';
+    }
+  } else {
+    hd44780_con[hd44780_con_pos++] = c;
+  }
+  if(hd44780_con_pos >= HD44780_CON_SIZE)
+    hd44780_con_pos = 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c.h Bit-banged I2C bus master.
+ * @author Thomas Reidemeister
+ */
+#ifndef I2C_H
+#define I2C_H
+
+#include <stdint.h>
+
+#include "delay.h"
+
+#define I2C_SCL P2_1
+#define I2C_SDA P2_0
+
+#define I2C_STANDARD 100000UL // Standard mode, 100kHz
+#define I2C_FAST     400000UL // Fast mode, 400kHz
+
+#ifndef I2C_SPEED
+#define I2C_SPEED I2C_STANDARD
+#endif
+
+// Minimum bus timing in machine cycles, the bit-bang code adds its own instructions on top
+#if I2C_SPEED == I2C_FAST
+#define I2C_T_LOW    NS_TO_CYCLES(1300) // SCL low
+#define I2C_T_HIGH   NS_TO_CYCLES(600)  // SCL high
+#define I2C_T_SU_STA NS_TO_CYCLES(600)  // Repeated START setup
+#define I2C_T_HD_STA NS_TO_CYCLES(600)  // START hold
+#define I2C_T_SU_STO NS_TO_CYCLES(600)  // STOP setup
+#define I2C_T_BUF    NS_TO_CYCLES(1300) // Bus free between STOP and START
+#elif I2C_SPEED == I2C_STANDARD
+#define I2C_T_LOW    NS_TO_CYCLES(4700)
+#define I2C_T_HIGH   NS_TO_CYCLES(4000)
+#define I2C_T_SU_STA NS_TO_CYCLES(4700)
+#define I2C_T_HD_STA NS_TO_CYCLES(4000)
+#define I2C_T_SU_STO NS_TO_CYCLES(4000)
+#define I2C_T_BUF    NS_TO_CYCLES(4700)
+#else
+#error "I2C_SPEED must be I2C_STANDARD or I2C_FAST"
+#endif
+
+#define I2C_STRETCH_POLLS 2000 // SCL reads before giving up on a slave stretching the clock (about 10ms)
+
+#define I2C_ACK  1 // i2c_read(): more bytes follow
+#define I2C_NACK 0 // i2c_read(): last byte of the transfer
+
+/**
+ * Release SCL and wait while a slave holds it low (clock stretching).
+ * @return 1 once SCL is high, 0 on timeout
+ */
+uint8_t i2c_scl_high(void);
+
+/**
+ * Generate a (repeated) START condition.
+ */
+void i2c_start(void);
+
+/**
+ * Generate a STOP condition.
+ */
+void i2c_stop(void);
+
+/**
+ * Write a byte MSB first and clock in the acknowledge.
+ * @param byte Byte to write
+ * @return 1 on ACK, 0 on NACK or clock stretching timeout
+ */
+uint8_t i2c_write(uint8_t byte);
+
+/**
+ * Read a byte MSB first and send the acknowledge bit.
+ * @param byte Byte read, left unchanged on a clock stretching timeout
+ * @param ack I2C_ACK to continue reading, I2C_NACK for the last byte
+ * @return 1 on success, 0 on clock stretching timeout
+ */
+uint8_t i2c_read(uint8_t *byte, uint8_t ack);
+
+/**
+ * Free a bus held by a slave that was reset mid-transfer: clock SCL up to nine times until SDA is released,
+ * then send a STOP.
+ * @return 1 if the bus is free, 0 if SDA is still held low
+ */
+uint8_t i2c_recover(void);
+
+/**
+ * Write transaction: START, address, data, STOP. A zero length write probes the address.
+ * @param addr 8-bit device address with the R/W bit clear (e.g. AT24C02_ADDR)
+ * @param data Bytes to write
+ * @param len Number of bytes
+ * @return 1 if every byte was acknowledged
+ */
+uint8_t i2c_write_buf(uint8_t addr, const uint8_t *data, uint8_t len);
+
+/**
+ * Read transaction: START, address, data (ACK on all but the last byte), STOP.
+ * @param addr 8-bit device address with the R/W bit clear
+ * @param data Output buffer
+ * @param len Number of bytes
+ * @return 1 if the address was acknowledged and every byte was read, 0 on NACK, clock stretching timeout or without
+ * bus traffic for a zero length
+ */
+uint8_t i2c_read_buf(uint8_t addr, uint8_t *data, uint8_t len);
+
+#endif // I2C_H
@@ -0,0 +1,44 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_read.c I2C byte read.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_read(uint8_t *byte, uint8_t ack) {
+  uint8_t ok = 1;
+  uint8_t b = 0;
+  I2C_SDA = 1; // Release SDA to the slave
+  for(uint8_t i = 0; i < 8; i++) { // MSB first
+    b <<= 1;
+    delay_cycles(I2C_T_LOW);
+    ok &= i2c_scl_high();
+    delay_cycles(I2C_T_HIGH);
+    b |= I2C_SDA;
+    I2C_SCL = 0;
+  }
+  // ACK bit
+  I2C_SDA = !ack; // Pull SDA low to acknowledge
+  delay_cycles(I2C_T_LOW);
+  ok &= i2c_scl_high();
+  delay_cycles(I2C_T_HIGH);
+  I2C_SCL = 0;
+  I2C_SDA = 1;
+  if(ok)
+    *byte = b; // SDA sampled on a bus held low is not data
+  return ok;
+}
@@ -0,0 +1,34 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_read_buf.c I2C read transaction.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_read_buf(uint8_t addr, uint8_t *data, uint8_t len) {
+  if(!len) // A read ends with a NACKed byte, the loop below would read 256
+    return 0;
+  i2c_start();
+  uint8_t ack = i2c_write(addr | 0x01); // Device address + Read
+  while(ack && --len) {
+    ack = i2c_read(data++, I2C_ACK);
+  }
+  if(ack) {
+    ack = i2c_read(data, I2C_NACK); // Last byte
+  }
+  i2c_stop();
+  return ack;
+}
@@ -0,0 +1,34 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_recover.c I2C bus recovery.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_recover(void) {
+  I2C_SDA = 1;
+  i2c_scl_high();
+  for(uint8_t i = 0; i < 9 && !I2C_SDA; i++) { // Let the slave finish the byte it is sending
+    I2C_SCL = 0;
+    delay_cycles(I2C_T_LOW);
+    i2c_scl_high();
+    delay_cycles(I2C_T_HIGH);
+  }
+  I2C_SCL = 0;
+  i2c_stop();
+  return I2C_SDA;
+}
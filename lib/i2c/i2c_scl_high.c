@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_scl_high.c Release SCL with clock stretching support.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_scl_high(void) {
+  I2C_SCL = 1;
+  for(uint16_t i = 0; !I2C_SCL; i++) { // Slave stretches the clock
+    if(i >= I2C_STRETCH_POLLS)
+      return 0;
+  }
+  return 1;
+}
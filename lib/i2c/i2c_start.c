@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_start.c I2C START condition.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+void i2c_start(void) {
+  I2C_SDA = 1;
+  i2c_scl_high(); // SCL is low before a repeated START
+  delay_cycles(I2C_T_SU_STA);
+  I2C_SDA = 0;
+  delay_cycles(I2C_T_HD_STA);
+  I2C_SCL = 0;
+}
@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_stop.c I2C STOP condition.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+void i2c_stop(void) {
+  I2C_SDA = 0;
+  delay_cycles(I2C_T_LOW);
+  i2c_scl_high();
+  delay_cycles(I2C_T_SU_STO);
+  I2C_SDA = 1;
+  delay_cycles(I2C_T_BUF);
+}
@@ -0,0 +1,40 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_write.c I2C byte write.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_write(uint8_t byte) {
+  uint8_t ok = 1;
+  for(uint8_t i = 0; i < 8; i++) { // MSB first
+    I2C_SDA = byte >> 7;
+    byte <<= 1;
+    delay_cycles(I2C_T_LOW);
+    ok &= i2c_scl_high();
+    delay_cycles(I2C_T_HIGH);
+    I2C_SCL = 0;
+  }
+  // ACK bit
+  I2C_SDA = 1; // Release SDA for ACK
+  delay_cycles(I2C_T_LOW);
+  ok &= i2c_scl_high();
+  delay_cycles(I2C_T_HIGH);
+  uint8_t ack = !I2C_SDA;
+  I2C_SCL = 0;
+  return ok && ack;
+}
@@ -0,0 +1,29 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file i2c_write_buf.c I2C write transaction.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "i2c.h"
+
+uint8_t i2c_write_buf(uint8_t addr, const uint8_t *data, uint8_t len) {
+  i2c_start();
+  uint8_t ack = i2c_write(addr & 0xFE); // Device address + Write
+  while(ack && len--) {
+    ack = i2c_write(*data++);
+  }
+  i2c_stop();
+  return ack;
+}
@@ -0,0 +1,49 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file keypad.h Interrupt driven 4x4 keypad scanner with debouncing and an event queue.
+ * @author Thomas Reidemeister
+ */
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include <stdint.h>
+
+#define KEYPAD_PORT P1 // Rows on P1_7..P1_4 (driven low one at a time), columns on P1_3..P1_0 (pulled up)
+#define KEYPAD_ROWS 4
+#define KEYPAD_COLS 4
+#define KEYPAD_KEYS (KEYPAD_ROWS * KEYPAD_COLS)
+
+#define KEYPAD_INTEGRATOR 3    // Consistent samples per key to change its state (each key is sampled every 4th tick)
+#define KEYPAD_QUEUE_SIZE 8    // Events, power of two
+#define KEYPAD_RELEASE    0x80 // Event flag for a released key, the low nibble is the key (0-15)
+#define KEYPAD_NONE       0xFF // No event
+
+extern volatile uint16_t keypad_state;                    // Debounced state, bit n set while key n is held
+extern volatile uint8_t keypad_queue[KEYPAD_QUEUE_SIZE];  // Event ring buffer
+extern volatile uint8_t keypad_head;                      // Written by keypad_scan() only
+extern volatile uint8_t keypad_tail;                      // Written by keypad_get() only
+
+/**
+ * Sample the row driven since the last call and drive the next one, call periodically from a timer interrupt
+ * (e.g. 1ms). Press and release events of the debounced keys are queued, events are dropped while the queue is full.
+ */
+void keypad_scan(void);
+
+/**
+ * Take the oldest event from the queue, safe against a concurrent keypad_scan() without disabling interrupts.
+ * @return Key (0-15), or'ed with KEYPAD_RELEASE on release, KEYPAD_NONE if the queue is empty
+ */
+uint8_t keypad_get(void);
+
+#endif // KEYPAD_H
@@ -0,0 +1,27 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file keypad_get.c Read keypad events.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "keypad.h"
+
+uint8_t keypad_get(void) {
+  if(keypad_tail == keypad_head)
+    return KEYPAD_NONE;
+  uint8_t event = keypad_queue[keypad_tail];
+  keypad_tail = (keypad_tail + 1) & (KEYPAD_QUEUE_SIZE - 1); // Free the slot after the event is read
+  return event;
+}
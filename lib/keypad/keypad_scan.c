@@ -0,0 +1,62 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file keypad_scan.c Keypad row scan and integrator debouncing.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "keypad.h"
+
+volatile uint16_t keypad_state = 0;
+volatile uint8_t keypad_queue[KEYPAD_QUEUE_SIZE];
+volatile uint8_t keypad_head = 0;
+volatile uint8_t keypad_tail = 0;
+static uint8_t keypad_integrator[KEYPAD_KEYS]; // Per key sample counter (0..KEYPAD_INTEGRATOR)
+static uint8_t keypad_row = 0; // Row driven since the last call
+
+// Called from the timer interrupt, keep the locals and parameters out of the overlay segment shared with the main
+// program, keypad_push() included since SDCC overlays it as a leaf function of keypad_scan()
+#pragma save
+#pragma nooverlay
+static void keypad_push(uint8_t event) {
+  uint8_t next = (keypad_head + 1) & (KEYPAD_QUEUE_SIZE - 1);
+  if(next != keypad_tail) { // Drop when full
+    keypad_queue[keypad_head] = event;
+    keypad_head = next; // Publish after the event is stored
+  }
+}
+
+void keypad_scan(void) {
+  uint8_t cols = ~KEYPAD_PORT & 0x0F; // Pressed keys of the row shorted to ground, settled for a full tick
+  uint8_t key = keypad_row * KEYPAD_COLS;
+
+  for(uint8_t mask = 0x08; mask; mask >>= 1, key++) { // P1_3 is column 0
+    uint8_t *integ = &keypad_integrator[key];
+    uint16_t bit = (uint16_t)1 << key;
+    if(cols & mask) {
+      if(*integ < KEYPAD_INTEGRATOR && ++(*integ) == KEYPAD_INTEGRATOR && !(keypad_state & bit)) {
+        keypad_state |= bit;
+        keypad_push(key);
+      }
+    } else if(*integ && --(*integ) == 0 && (keypad_state & bit)) {
+      keypad_state &= ~bit;
+      keypad_push(key | KEYPAD_RELEASE);
+    }
+  }
+
+  keypad_row = (keypad_row + 1) & (KEYPAD_ROWS - 1);
+  KEYPAD_PORT = ~(0x80 >> keypad_row); // Drive the next row low, release the others and the columns
+}
+#pragma restore
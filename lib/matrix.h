@@ -0,0 +1,46 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file matrix.h Interrupt driven refresh of the 8x8 LED matrix (rows via 74HC595, columns on P0).
+ * @author Thomas Reidemeister
+ */
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stdint.h>
+
+#define MATRIX_COLS P0 // Column data, active low
+#define MATRIX_ROWS 8
+
+extern volatile uint8_t matrix_frames[2][MATRIX_ROWS]; // Front and back buffer, bit 7 is the leftmost column
+extern volatile uint8_t matrix_front;                  // Index of the frame shown by matrix_scan()
+extern volatile __bit matrix_swap_pending;             // Set by matrix_swap(), cleared when the frames are swapped
+
+/**
+ * Frame the application draws into, shown after matrix_swap().
+ */
+#define matrix_back() (matrix_frames[matrix_front ^ 1])
+
+/**
+ * Show the next row of the front buffer, call periodically from a timer interrupt (e.g. 1ms gives 125Hz).
+ * The row stays lit until the next call, so the refresh rate does not depend on the main loop.
+ */
+void matrix_scan(void);
+
+/**
+ * Make the back buffer the front buffer at the start of the next frame and wait for it, so a frame is never shown
+ * half old and half new. The old front buffer is the new back buffer afterwards.
+ */
+void matrix_swap(void);
+
+#endif // MATRIX_H
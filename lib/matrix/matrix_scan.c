@@ -0,0 +1,45 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file matrix_scan.c Row scanner for the 8x8 LED matrix.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "hc595.h"
+#include "matrix.h"
+
+volatile uint8_t matrix_frames[2][MATRIX_ROWS]; // Double buffer for frames
+volatile uint8_t matrix_front = 0;
+volatile __bit matrix_swap_pending = 0;
+static uint8_t matrix_row = 0; // current row index
+
+// Called from the timer interrupt, keep the locals out of the overlay segment shared with the main program
+#pragma save
+#pragma nooverlay
+void matrix_scan(void) {
+  if(matrix_row == 0 && matrix_swap_pending) { // Swap only between frames
+    matrix_front ^= 1;
+    matrix_swap_pending = 0;
+  }
+
+  HC575_write(0); // Turn off all rows to avoid ghosting
+  MATRIX_COLS = ~matrix_frames[matrix_front][matrix_row]; // invert since active low
+  HC575_write(1 << (7 - matrix_row)); // Scan from top to bottom
+
+  matrix_row++;
+  if(matrix_row >= MATRIX_ROWS)
+    matrix_row = 0;
+}
+#pragma restore
@@ -0,0 +1,73 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file nec.h NEC infrared decoder timing the INT0 edges with Timer 0.
+ * @author Thomas Reidemeister
+ */
+#ifndef NEC_H
+#define NEC_H
+
+#include <stdint.h>
+
+#include "delay.h" // US_TO_CYCLES
+
+/*
+ * Only the NEC protocol is decoded. RC5 is not supported: its Manchester bits need both edges of the receiver
+ * output, and INT0 only interrupts on falling edges.
+ */
+
+#define NEC_RX P3_2 // IR receiver output (active low) on INT0
+
+// Falling edge to falling edge intervals in machine cycles (Timer 0 counts), +-1ms for the leaders, bits in between
+#define NEC_LEADER_MIN US_TO_CYCLES(12500) // 9ms mark + 4.5ms space
+#define NEC_LEADER_MAX US_TO_CYCLES(14500)
+#define NEC_REPEAT_MIN US_TO_CYCLES(10250) // 9ms mark + 2.25ms space
+#define NEC_REPEAT_MAX US_TO_CYCLES(12250)
+#define NEC_BIT_MIN    US_TO_CYCLES(800)   // 0: 1.125ms
+#define NEC_BIT_SPLIT  US_TO_CYCLES(1690)
+#define NEC_BIT_MAX    US_TO_CYCLES(2700)  // 1: 2.25ms
+
+static_assert(NEC_LEADER_MAX < 0x10000UL, "NEC leader does not fit the 16-bit Timer 0");
+
+#define NEC_QUEUE_SIZE 4 // Frames, power of two
+
+struct nec_frame {
+  uint16_t address; // 8-bit address or 16-bit extended address (when the second byte is not the inverted first)
+  uint8_t command;
+  uint8_t repeat;   // 0 for a full frame, counts up for every repeat code while the key is held
+};
+
+extern volatile struct nec_frame nec_queue[NEC_QUEUE_SIZE]; // Frame ring buffer
+extern volatile uint8_t nec_head;                           // Written by nec_edge() only
+extern volatile uint8_t nec_tail;                           // Written by nec_get() only
+
+/**
+ * Start Timer 0 (no interrupt) and enable INT0 on falling edges. nec_edge() restarts the timer, so TH0/TL0 hold the
+ * time since the last edge and TF0 flags a longer gap than the timer can count.
+ */
+void nec_init(void);
+
+/**
+ * Time a falling edge and advance the decoder, call from the INT0 interrupt handler. Frames with a corrupted
+ * command (second byte not inverted) are dropped, as are frames arriving while the queue is full.
+ */
+void nec_edge(void);
+
+/**
+ * Take the oldest frame from the queue, safe against a concurrent nec_edge() without disabling interrupts.
+ * @param frame Output
+ * @return 1 if a frame was taken, 0 if the queue is empty
+ */
+uint8_t nec_get(struct nec_frame *frame);
+
+#endif // NEC_H
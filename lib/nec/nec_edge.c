@@ -0,0 +1,92 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file nec_edge.c NEC decoder state machine.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "nec.h"
+
+volatile struct nec_frame nec_queue[NEC_QUEUE_SIZE];
+volatile uint8_t nec_head = 0;
+volatile uint8_t nec_tail = 0;
+
+static uint8_t nec_bits = 0xFF; // Bits received, 0xFF while waiting for a leader
+static uint32_t nec_data;
+static struct nec_frame nec_frame; // Last valid frame, sent again for repeat codes
+static __bit nec_valid = 0;
+
+// Called from the INT0 interrupt, keep the locals out of the overlay segment shared with the main program,
+// nec_push() included since SDCC overlays it as a leaf function of nec_edge()
+#pragma save
+#pragma nooverlay
+static void nec_push(void) {
+  uint8_t next = (nec_head + 1) & (NEC_QUEUE_SIZE - 1);
+  if(next != nec_tail) { // Drop when full
+    volatile struct nec_frame *q = &nec_queue[nec_head];
+    q->address = nec_frame.address;
+    q->command = nec_frame.command;
+    q->repeat = nec_frame.repeat;
+    nec_head = next; // Publish after the frame is stored
+  }
+}
+
+void nec_edge(void) {
+  uint8_t th = TH0;
+  uint8_t tl = TL0;
+  if(th != TH0) { // TL0 wrapped between the reads
+    th = TH0;
+    tl = TL0;
+  }
+  TL0 = 0; // Restart for the next interval, the few cycles since the read are far below the tolerances
+  TH0 = 0;
+  uint16_t interval = ((uint16_t)th << 8) | tl;
+  uint8_t idle = TF0; // Wrapped once or more, over 65536 cycles since the last edge whatever the count shows
+  TF0 = 0;
+
+  if(idle) {
+    nec_bits = 0xFF;
+  } else if(interval >= NEC_LEADER_MIN && interval <= NEC_LEADER_MAX) {
+    nec_bits = 0;
+  } else if(interval >= NEC_REPEAT_MIN && interval <= NEC_REPEAT_MAX) {
+    if(nec_valid && nec_frame.repeat < 0xFF) {
+      nec_frame.repeat++;
+      nec_push();
+    }
+    nec_bits = 0xFF;
+  } else if(nec_bits < 32 && interval >= NEC_BIT_MIN && interval <= NEC_BIT_MAX) {
+    nec_data >>= 1; // LSB first
+    if(interval >= NEC_BIT_SPLIT) {
+      nec_data |= 0x80000000UL;
+    }
+    if(++nec_bits == 32) {
+      uint8_t addr = nec_data, naddr = nec_data >> 8, cmd = nec_data >> 16, ncmd = nec_data >> 24;
+      nec_valid = (uint8_t)~cmd == ncmd;
+      if(nec_valid) {
+        nec_frame.address = ((uint8_t)~addr == naddr) ? addr : ((uint16_t)naddr << 8) | addr;
+        nec_frame.command = cmd;
+        nec_frame.repeat = 0;
+        nec_push();
+      }
+      nec_bits = 0xFF;
+    }
+  } else { // Glitch or gap between frames
+    if(nec_bits != 0xFF) {
+      nec_valid = 0; // Repeat codes only follow a complete frame
+    }
+    nec_bits = 0xFF;
+  }
+}
+#pragma restore
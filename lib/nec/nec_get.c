@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file nec_get.c Read decoded NEC frames.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "nec.h"
+
+uint8_t nec_get(struct nec_frame *frame) {
+  if(nec_tail == nec_head)
+    return 0;
+  volatile struct nec_frame *q = &nec_queue[nec_tail];
+  frame->address = q->address;
+  frame->command = q->command;
+  frame->repeat = q->repeat;
+  nec_tail = (nec_tail + 1) & (NEC_QUEUE_SIZE - 1); // Free the slot after the frame is read
+  return 1;
+}
@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file nec_init.c Set up Timer 0 and INT0 for the NEC decoder.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "nec.h"
+#include "timer.h"
+
+void nec_init(void) {
+  timer0_init(0x0000); // Restarted by every edge, TF0 flags a gap of 65536 cycles or more
+  ET0 = 0;  /* Edges are timed by reading TH0/TL0, no overflow interrupt */
+  IT0 = 1;  /* INT0 (P3.2) Falling Edge */
+  EX0 = 1;  /* Enable INT0 (P3.2) */
+}
@@ -0,0 +1,50 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file power.h Idle and power-down modes with idle time accounting.
+ * @author Thomas Reidemeister
+ */
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+
+#define POWER_WAKE_INT0 0x01 // P3_2
+#define POWER_WAKE_INT1 0x02 // P3_3
+
+extern uint32_t power_idle_cycles; // Machine cycles spent in idle mode since the last power_idle_percent()
+extern uint16_t power_window;      // Timebase tick of the last power_idle_percent()
+
+/**
+ * Idle mode (PCON IDL) until the next interrupt, the time spent (including the handler of the waking interrupt)
+ * is added to power_idle_cycles. The clock keeps
+ * running for the timers and the serial port, only the CPU stops. Needs the timebase (lib/timebase.h).
+ */
+void power_idle(void);
+
+/**
+ * Share of time spent in idle mode since the previous call (at most 65535 ticks ago).
+ * @return 0-100 percent
+ */
+uint8_t power_idle_percent(void);
+
+/**
+ * Power-down mode (PCON PD): the oscillator stops, the ports keep their levels, only an external interrupt
+ * wakes the CPU. The selected inputs are armed falling edge triggered while asleep, their interrupt handlers
+ * must exist in the image and global interrupts must be enabled. The timers (and the system tick) stand still
+ * while powered down and the crystal takes a few ms to start again.
+ * @param wake POWER_WAKE_INT0 and/or POWER_WAKE_INT1
+ */
+void power_down(uint8_t wake);
+
+#endif // POWER_H
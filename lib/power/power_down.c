@@ -0,0 +1,42 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file power_down.c Power-down mode with external interrupt wake-up.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "power.h"
+
+void power_down(uint8_t wake) {
+  __bit ex0 = EX0;
+  __bit ex1 = EX1;
+  __bit it0 = IT0;
+  __bit it1 = IT1;
+  if(wake & POWER_WAKE_INT0) {
+    IT0 = 1; // Falling edge, a held button fires once
+    IE0 = 0;
+    EX0 = 1;
+  }
+  if(wake & POWER_WAKE_INT1) {
+    IT1 = 1;
+    IE1 = 0;
+    EX1 = 1;
+  }
+  PCON |= PD; // Returns after the handler of the waking interrupt
+  EX0 = ex0;
+  EX1 = ex1;
+  IT0 = it0;
+  IT1 = it1;
+}
@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file power_idle.c Idle mode with accounting.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "power.h"
+#include "timebase.h"
+
+uint32_t power_idle_cycles = 0;
+uint16_t power_window = 0;
+
+void power_idle(void) {
+  uint32_t tick;
+  uint16_t start = timebase_clock(&tick);
+  PCON |= IDL; // Returns after the handler of the waking interrupt
+  power_idle_cycles += timebase_since(tick, start);
+}
@@ -0,0 +1,36 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file power_idle_percent.c Idle time share.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "power.h"
+#include "timebase.h"
+
+uint8_t power_idle_percent(void) {
+  __bit ea = EA;
+  EA = 0; // Counter shared with the interrupt
+  uint16_t now = (uint16_t)timebase_ticks;
+  EA = ea;
+  uint32_t total = (uint32_t)(uint16_t)(now - power_window) * TIMEBASE_CYCLES / 100;
+  uint32_t idle = power_idle_cycles;
+  power_window = now;
+  power_idle_cycles = 0;
+  if(!total)
+    return 0;
+  idle /= total; // Once per report, the idle path itself only adds
+  return idle > 100 ? 100 : (uint8_t)idle;
+}
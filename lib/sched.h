@@ -0,0 +1,88 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sched.h Run-to-completion task scheduler on a single system tick.
+ * @author Thomas Reidemeister
+ */
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+#include "timebase.h"
+
+#define SCHED_MS(ms) ((uint16_t)TIMEBASE_MS(ms)) // Ticks of a period
+
+#ifndef SCHED_TASKS
+#define SCHED_TASKS 8 // Slots, periodic and one-shot tasks share the table
+#endif
+#define SCHED_NONE  0xFF // No free slot
+
+#ifndef SCHED_MEM
+#define SCHED_MEM __idata
+#endif
+
+struct sched_task {
+  void (*run)(void); // 0 for a free slot
+  uint16_t period;   // Ticks between runs, 0 for a one-shot task (the slot is freed before it runs)
+  uint16_t due;      // Tick of the next run
+  uint16_t worst;    // Longest run in machine cycles including interrupts, saturates at 0xFFFF
+};
+
+extern SCHED_MEM struct sched_task sched_tasks[SCHED_TASKS];
+
+/**
+ * Clear the task table and start the timebase (lib/timebase.h), whose tick is the system tick. The caller
+ * enables its interrupt (ET2) and calls timebase_tick() from the handler.
+ */
+void sched_init(void);
+
+/**
+ * Read the tick counter with interrupts masked.
+ * @return Low 16 bits of timebase_ticks
+ */
+uint16_t sched_now(void);
+
+/**
+ * Add a task, from the main loop or from a task (not from interrupts).
+ * @param run Function to call, runs to completion
+ * @param delay Ticks until the first run
+ * @param period Ticks between runs (< 0x8000), 0 to run once
+ * @return Slot for sched_cancel(), SCHED_NONE if the table is full
+ */
+uint8_t sched_add(void (*run)(void), uint16_t delay, uint16_t period);
+
+/**
+ * Periodic task, first run one period from now.
+ */
+#define sched_every(run, period) sched_add((run), (period), (period))
+
+/**
+ * One-shot task.
+ */
+#define sched_after(run, delay) sched_add((run), (delay), 0)
+
+/**
+ * Remove a task.
+ * @param slot From sched_add()
+ */
+void sched_cancel(uint8_t slot);
+
+/**
+ * Run every task that is due once and record its run time. A periodic task that fell behind runs again on the
+ * next call until it caught up, its schedule does not drift.
+ * @return 1 if a task ran, 0 if nothing was due (the caller may idle until the next interrupt)
+ */
+uint8_t sched_run(void);
+
+#endif // SCHED_H
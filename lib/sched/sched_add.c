@@ -0,0 +1,34 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sched_add.c Add a task.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "sched.h"
+
+uint8_t sched_add(void (*run)(void), uint16_t delay, uint16_t period) {
+  for(uint8_t i = 0; i < SCHED_TASKS; i++) {
+    SCHED_MEM struct sched_task *t = &sched_tasks[i];
+    if(!t->run) {
+      t->period = period;
+      t->due = sched_now() + delay;
+      t->worst = 0;
+      t->run = run;
+      return i;
+    }
+  }
+  return SCHED_NONE;
+}
@@ -0,0 +1,47 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sched_run.c Run the due tasks.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "sched.h"
+#include "timebase.h"
+
+uint8_t sched_run(void) {
+  uint8_t ran = 0;
+  uint16_t now = sched_now();
+  for(uint8_t i = 0; i < SCHED_TASKS; i++) {
+    SCHED_MEM struct sched_task *t = &sched_tasks[i];
+    void (*run)(void) = t->run;
+    if(!run || (int16_t)(now - t->due) < 0)
+      continue;
+    if(t->period) {
+      t->due += t->period;
+    } else {
+      t->run = 0; // Free before running, the task may schedule itself again
+    }
+    uint32_t tick;
+    uint16_t start = timebase_clock(&tick);
+    run();
+    uint16_t c = timebase_since(tick, start);
+    if(t->run == run || !t->run) { // Slot not taken over by another task meanwhile
+      if(c > t->worst)
+        t->worst = c;
+    }
+    ran = 1;
+  }
+  return ran;
+}
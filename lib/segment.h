@@ -0,0 +1,94 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file segment.h Multiplexed 7-segment display on the HC6800-ES (P0 segments, P2_2..P2_4 digit select).
+ * @author Thomas Reidemeister
+ */
+#ifndef SEGMENT_H
+#define SEGMENT_H
+
+#include <stdint.h>
+
+#include "bcd.h"
+#include "delay.h"
+
+#define LED_DIGIT P0
+#define SEGMENT_SELECT       P2 // Digit index into the 74HC138 on P2_2..P2_4
+#define SEGMENT_SELECT_SHIFT 2
+#define SEGMENT_SELECT_MASK  (0x07 << SEGMENT_SELECT_SHIFT)
+
+#define SEGMENT_DIGITS 8
+#define SEGMENT_DP     0b10000000 // Decimal point segment
+#define SEGMENT_MINUS  0b01000000 // '-' pattern
+#define SEGMENT_BLANK  0x00       // Pattern with all segments off
+
+#ifndef SEGMENT_TICK
+#define SEGMENT_TICK   ((uint16_t)US_TO_CYCLES(1000)) // Machine cycles each digit is shown (1ms, 125Hz refresh)
+#endif
+#define SEGMENT_LEVELS 8          // Brightness steps, each SEGMENT_TICK / SEGMENT_LEVELS of on time
+#define SEGMENT_BLINK_TICKS 250   // Blinking digits toggle every 250 ticks (2Hz)
+
+extern const uint8_t segment_map[16];       // Hex digit to segment pattern
+extern volatile uint8_t segment_digits[SEGMENT_DIGITS]; // Segment patterns shown by segment_scan(), least significant digit first
+extern volatile uint8_t segment_blink;      // Bit i set: digit i blinks
+extern volatile uint8_t segment_blank;      // Bit i set: digit i is dark, its pattern is kept
+extern uint16_t segment_reload;             // Timer reload for the next interrupt, set by segment_scan()
+extern uint16_t segment_on;                 // Cycles each digit is lit per tick, set by segment_brightness()
+
+/**
+ * Show the next digit of segment_digits, call from a timer interrupt reloaded with segment_reload.
+ *
+ * Below full brightness every tick takes two interrupts: the digit is lit for the on time and blanked for the
+ * rest of the tick, so the tick period stays SEGMENT_TICK. Only the digit select bits of P2 are written.
+ * @return 1 at the start of a tick (once per SEGMENT_TICK), 0 for the brightness interrupt within a tick
+ */
+uint8_t segment_scan(void);
+
+/**
+ * Set the brightness of the whole display.
+ * @param level 0 (dark) to SEGMENT_LEVELS (full, one interrupt per tick)
+ */
+void segment_brightness(uint8_t level);
+
+/**
+ * Encode decimal digits right aligned into segment_digits, blank leading zeros and place sign and decimal point.
+ * Numbers that do not fit the display show all dashes.
+ * @param bcd Digits, least significant first
+ * @param len Number of digits in bcd (leading zeros included)
+ * @param negative 1 to put a minus in front
+ * @param decimals Digits after the decimal point (0 for none)
+ */
+void segment_bcd(const uint8_t *bcd, uint8_t len, uint8_t negative, uint8_t decimals);
+
+/**
+ * Show a number, see segment_bcd().
+ * @param val Value
+ * @param decimals Digits after the decimal point, e.g. 1 shows 123 as 12.3
+ */
+void segment_u8(uint8_t val, uint8_t decimals);
+void segment_s8(int8_t val, uint8_t decimals);
+void segment_u16(uint16_t val, uint8_t decimals);
+void segment_s16(int16_t val, uint8_t decimals);
+void segment_u32(uint32_t val, uint8_t decimals);
+void segment_s32(int32_t val, uint8_t decimals);
+
+extern uint8_t segment_bcd_buf[BCD_U32_DIGITS]; // Scratch digits of segment_u8() .. segment_s32()
+
+/**
+ * Split a number into decimal digits, least significant digit first (uses division, see segment_s16()).
+ * @param val Number to convert (sign is dropped)
+ * @param ptr Output buffer of SEGMENT_DIGITS digits
+ */
+void int_to_digits(int16_t val, volatile uint8_t *ptr);
+
+#endif // SEGMENT_H
@@ -0,0 +1,40 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file int_to_digits.c Decimal digit conversion for the 7-segment display.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "segment.h"
+
+void int_to_digits(int16_t val, volatile uint8_t *ptr) {
+  for(uint8_t i = 0; i < SEGMENT_DIGITS; i++) {
+    ptr[i] = 0;
+  }
+  int i = 7; // Start filling the array from the rightmost index
+
+  int16_t temp_N = (val < 0) ? -val : val;
+
+  // Loop while there are digits left and we have array space
+  while (temp_N > 0 && i >= 0) {
+    // 1. Get the rightmost digit (modulo 10)
+    ptr[7-i] = temp_N % 10;
+
+    // 2. Remove the rightmost digit (integer division by 10)
+    temp_N = temp_N / 10;
+
+    // 3. Move to the next position in the array (left)
+    i = i - 1;
+  }
+}
@@ -0,0 +1,43 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file segment_bcd.c Right aligned decimal number on the 7-segment display.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "segment.h"
+
+uint8_t segment_bcd_buf[BCD_U32_DIGITS];
+
+void segment_bcd(const uint8_t *bcd, uint8_t len, uint8_t negative, uint8_t decimals) {
+  uint8_t shown = len;
+  while(shown > decimals + 1 && bcd[shown - 1] == 0) // Blank leading zeros, keep the one before the point
+    shown--;
+  if(shown <= decimals)
+    shown = decimals + 1; // .05 shows as 0.05
+  if(shown + negative > SEGMENT_DIGITS) {
+    for(uint8_t i = 0; i < SEGMENT_DIGITS; i++) {
+      segment_digits[i] = SEGMENT_MINUS; // Overflow
+    }
+    return;
+  }
+  for(uint8_t i = 0; i < SEGMENT_DIGITS; i++) {
+    segment_digits[i] = i < shown ? segment_map[i < len ? bcd[i] : 0] : SEGMENT_BLANK;
+  }
+  if(negative)
+    segment_digits[shown] = SEGMENT_MINUS;
+  if(decimals)
+    segment_digits[decimals] |= SEGMENT_DP;
+}
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file segment_brightness.c 7-segment display brightness.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "segment.h"
+
+void segment_brightness(uint8_t level) {
+  uint16_t on = (SEGMENT_TICK / SEGMENT_LEVELS) * level;
+  if(level >= SEGMENT_LEVELS)
+    on = SEGMENT_TICK; // No rounding loss at full brightness
+  __bit ea = EA;
+  EA = 0; // 16-bit value read by segment_scan()
+  segment_on = on;
+  EA = ea;
+}
@@ -0,0 +1,25 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file segment_s16.c Signed 16-bit number on the 7-segment display.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "segment.h"
+
+void segment_s16(int16_t val, uint8_t decimals) {
+  uint8_t negative = val < 0;
+  bcd_u16(negative ? 0 - (uint16_t)val : (uint16_t)val, segment_bcd_buf); // Magnitude of the minimum fits unsigned
+  segment_bcd(segment_bcd_buf, BCD_U16_DIGITS, negative, decimals);
+}
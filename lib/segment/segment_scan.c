@@ -0,0 +1,64 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file segment_scan.c 7-segment display multiplexing.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "segment.h"
+
+volatile uint8_t segment_digits[SEGMENT_DIGITS]; // Buffer for segment patterns
+volatile uint8_t segment_blink = 0;
+volatile uint8_t segment_blank = 0;
+uint16_t segment_reload = 0 - SEGMENT_TICK;
+uint16_t segment_on = SEGMENT_TICK; // Cycles each digit is lit, set by segment_brightness()
+static uint8_t seg_digit = 0; // current display index
+static uint8_t seg_mask = 1;  // 1 << seg_digit
+static uint8_t seg_blink_ticks = 0;
+static __bit seg_blink_off = 0;
+static __bit seg_dimmed = 0;  // Brightness interrupt pending within the tick
+
+uint8_t segment_scan(void) {
+  LED_DIGIT = 0x00; // Turn off all segments
+  if(seg_dimmed) { // Dark for the rest of the tick
+    seg_dimmed = 0;
+    segment_reload = 0 - (SEGMENT_TICK - segment_on);
+    return 0;
+  }
+
+  seg_digit++;
+  seg_mask <<= 1;
+  if(seg_digit >= SEGMENT_DIGITS) {
+    seg_digit = 0;
+    seg_mask = 1;
+  }
+  if(++seg_blink_ticks >= SEGMENT_BLINK_TICKS) {
+    seg_blink_ticks = 0;
+    seg_blink_off = !seg_blink_off;
+  }
+  // ANL/ORL modify the latch, the other P2 pins (I2C, LCD control) keep their state
+  SEGMENT_SELECT &= ~SEGMENT_SELECT_MASK;
+  SEGMENT_SELECT |= seg_digit << SEGMENT_SELECT_SHIFT;
+
+  segment_reload = 0 - SEGMENT_TICK;
+  if(!segment_on || (segment_blank & seg_mask) || (seg_blink_off && (segment_blink & seg_mask)))
+    return 1;
+  LED_DIGIT = segment_digits[seg_digit]; // Pre-encoded, no table lookup
+  if(segment_on != SEGMENT_TICK) {
+    seg_dimmed = 1;
+    segment_reload = 0 - segment_on;
+  }
+  return 1;
+}
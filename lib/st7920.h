@@ -0,0 +1,105 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920.h ST7920 128x64 graphic LCD in serial mode.
+ * @author Thomas Reidemeister
+ */
+#ifndef ST7920_H
+#define ST7920_H
+
+#include <stdint.h>
+
+#include "delay.h"
+
+#define ST7920_SCLK P2_7
+#define ST7920_CS P2_6
+#define ST7920_SID P2_5
+#define ST7920_RST P3_4
+
+#define ST7920_DISP_ON         0x0C
+#define ST7920_ADDR            0x80 // Set DDRAM/GDRAM address command
+#define ST7920_EXTENDED_MODE   0x34 // Extended instruction set (GRAM vs DRAM)
+#define ST7920_GRAPHICS_MODE   0x36 // Graphics mode (actually enable GRAM for display)
+
+/*
+ * An instruction or data write executes for 72us once its low nibble byte is in, the next write must not complete
+ * earlier. Two nibble bytes take at least ST7920_BYTE_CYCLES each, every write is followed by the rest of the
+ * execution time (nothing at 12MHz 12T, 178 cycles at 22.1184MHz 6T).
+ */
+#define ST7920_EXEC_CYCLES US_TO_CYCLES(72)
+#define ST7920_BYTE_CYCLES 44UL // Shortest st7920_byte(), the assembly kernel including ret, the C loop is slower
+#define ST7920_WRITE_PAD   (ST7920_EXEC_CYCLES > 2 * ST7920_BYTE_CYCLES ? \
+                            ST7920_EXEC_CYCLES - 2 * ST7920_BYTE_CYCLES : 0)
+
+/**
+ * Clock out one byte MSB first on SID/SCLK.
+ * @param d Byte to send
+ */
+void st7920_byte(uint8_t d);
+
+/**
+ * Send an instruction (RS=0).
+ * @param cmd Instruction byte
+ */
+void st7920_command(uint8_t cmd);
+
+/**
+ * Write a byte to DDRAM/GDRAM (RS=1).
+ * @param data Data byte
+ */
+void st7920_data(uint8_t data);
+
+/**
+ * Start a burst of data bytes (RS=1), the sync byte is only sent once.
+ * Finish with st7920_end() before the next st7920_command().
+ */
+void st7920_begin_data(void);
+
+/**
+ * Write a byte to DDRAM/GDRAM within a burst, 16 instead of 24 clocks per byte.
+ * @param data Data byte
+ */
+void st7920_stream(uint8_t data);
+
+/**
+ * Finish a burst started with st7920_begin_data().
+ */
+void st7920_end(void);
+
+/**
+ * Write a zero terminated string at the current text position.
+ * @param str Text
+ */
+void st7920_text(const char* str);
+
+/**
+ * Set graphics cursor position
+ * @param x Word of bit mask in X direction (0-8) (i.e. bit 0..128)
+ * @param y Row in Y direction (0-63)
+ *
+ * Note the 12864B-V2.3 seems to be mapped such that 256x32 pixels are 128x64 with the overflow going to the next row.
+ *
+ * +--------------------+--------------------+
+ * | Row 1: 0...7       | Row 32: 8...15     |
+ * | Row 2: 0...7       | Row 33: 8...15     |
+ * |....                | ...                |
+ * +--------------------+--------------------+
+ */
+void st7920_pos(uint8_t x, uint8_t y);
+
+/**
+ * Reset the controller and wait for it to come up (basic instruction set).
+ */
+void st7920_init(void);
+
+#endif // ST7920_H
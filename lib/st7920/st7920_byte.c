@@ -0,0 +1,49 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_byte.c ST7920 serial byte transfer.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "asm.h"
+#include "st7920.h"
+
+#ifdef HAL_ASM_KERNELS
+// One bit: SCLK low, MSB into carry, carry to SID, SCLK high (5 cycles)
+#define ST7920_BIT \
+    "\tclr\t" ASM_SYM(ST7920_SCLK) "\n" \
+    "\trlc\ta\n" \
+    "\tmov\t" ASM_SYM(ST7920_SID) ",c\n" \
+    "\tsetb\t" ASM_SYM(ST7920_SCLK) "\n"
+
+void st7920_byte(uint8_t d) __naked { // 44 cycles including ret
+  (void)d; // Passed in DPL
+  __asm__(
+    "\tmov\ta,dpl\n"
+    ST7920_BIT ST7920_BIT ST7920_BIT ST7920_BIT ST7920_BIT ST7920_BIT ST7920_BIT ST7920_BIT
+    "\tclr\t" ASM_SYM(ST7920_SCLK) "\n" // Reset state
+    "\tret\n");
+}
+#else
+void st7920_byte(uint8_t d) {
+  for(uint8_t i = 0; i < 8; i++) { // MSB first
+    ST7920_SCLK = 0; // Toggle bits on rising edge
+    ST7920_SID = d & 0x80;
+    d <<= 1;
+    ST7920_SCLK = 1; // Reset state
+  }
+  ST7920_SCLK = 0; // Reset state
+}
+#endif
@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_data.c ST7920 data write.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "st7920.h"
+
+void st7920_data(uint8_t data) {
+  ST7920_CS = 1;
+  st7920_byte(0b11111010);
+  //                 |+- RS set to 1 for data
+  //                 +-- RW set to 0 for write
+  st7920_byte(0xF0 & data);        // high nibble
+  st7920_byte(0xF0 & (data << 4)); // low nibble
+  delay_cycles(ST7920_WRITE_PAD); // Execution time before the next write
+  ST7920_CS = 0;
+}
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_init.c ST7920 reset sequence.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "st7920.h"
+
+void st7920_init(void) { // Figure 8-bit interface from ST7920 datasheet
+  ST7920_SCLK = 0; // Reset state
+  ST7920_RST = 0; // Force reset
+  ST7920_CS = 0;  // Defined state
+  delay_ms(40); // Wait for more than 40ms after Vcc rises to 4.5V
+  ST7920_RST = 1;
+  delay_ms(40);
+}
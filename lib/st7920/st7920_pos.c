@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_pos.c ST7920 graphics cursor.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920.h"
+
+void st7920_pos(uint8_t x, uint8_t y) {
+  if(y >= 32) { // Wrap around for 128x64 mode
+    x += 8;
+    y -= 32;
+  }
+  st7920_command(ST7920_ADDR | (y & 0x3F)); // Set GDRAM Y address
+  st7920_command(ST7920_ADDR | (x & 0x0F)); // Set GDRAM X address
+}
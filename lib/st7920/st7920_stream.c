@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_stream.c Send one data byte of a burst.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920.h"
+
+static_assert(2 * ST7920_BYTE_CYCLES + ST7920_WRITE_PAD >= ST7920_EXEC_CYCLES, "ST7920 write faster than 72us");
+static_assert(NS_TO_CYCLES(200) <= 1, "SCLK pulse of one cycle shorter than the 200ns the ST7920 needs");
+
+void st7920_stream(uint8_t data) {
+  st7920_byte(0xF0 & data);        // high nibble
+  st7920_byte(0xF0 & (data << 4)); // low nibble
+  delay_cycles(ST7920_WRITE_PAD); // Execution time before the next write
+}
@@ -0,0 +1,104 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_fb.h Shadow framebuffer for the ST7920 graphics mode, only changed GDRAM words are sent.
+ * @author Thomas Reidemeister
+ */
+#ifndef ST7920_FB_H
+#define ST7920_FB_H
+
+#include <stdint.h>
+
+#include "st7920.h"
+
+#define ST7920_FB_WIDTH  128
+#define ST7920_FB_HEIGHT 64
+#define ST7920_FB_WORDS  (ST7920_FB_WIDTH / 16)  // GDRAM words per row
+#define ST7920_FB_STRIDE (ST7920_FB_WIDTH / 8)   // Bytes per row
+
+/*
+ * A full 128x64 framebuffer takes 1 KB, the STC89C52 has 256 bytes of on-chip XRAM. The buffer therefore holds a
+ * band of ST7920_FB_ROWS rows (136 bytes with the dirty bits at 8 rows) that is moved over the display with
+ * st7920_fb_band(), drawing outside the band is ignored. A part with more XRAM can raise ST7920_FB_ROWS up to
+ * ST7920_FB_HEIGHT together with ST7920_FB_XRAM.
+ */
+#ifndef ST7920_FB_ROWS
+#define ST7920_FB_ROWS 8
+#endif
+#ifndef ST7920_FB_XRAM
+#define ST7920_FB_XRAM 256 // On-chip XRAM of the STC89C52
+#endif
+#define ST7920_FB_SIZE (ST7920_FB_ROWS * ST7920_FB_STRIDE)
+
+// Memory space of the framebuffer band
+#ifndef ST7920_FB_MEM
+#define ST7920_FB_MEM __xdata
+#endif
+
+extern ST7920_FB_MEM uint8_t st7920_fb[ST7920_FB_SIZE]; // Pixels of the band, MSB is leftmost
+extern ST7920_FB_MEM uint8_t st7920_fb_dirty[ST7920_FB_ROWS]; // Bit x set if word x of the row changed
+extern uint8_t st7920_fb_top; // Display row of the first band row
+
+/**
+ * Move the band to start at a display row. The buffer keeps its content and all of the band is marked changed,
+ * fill or blit it before the next flush, or call st7920_fb_validate() when the blit matches the display.
+ * @param top First row (0 to ST7920_FB_HEIGHT - ST7920_FB_ROWS)
+ */
+void st7920_fb_band(uint8_t top);
+
+/**
+ * Mark the whole band as changed, e.g. after st7920_init() when the GDRAM content is unknown.
+ */
+void st7920_fb_invalidate(void);
+
+/**
+ * Mark the whole band as matching the display, e.g. after st7920_fb_band() and a blit of the bitmap that is already
+ * shown, so that the next flush only sends what is drawn afterwards.
+ */
+void st7920_fb_validate(void);
+
+/**
+ * Fill the band with a byte pattern.
+ * @param pattern Byte written to every 8 pixels (0x00 clears)
+ */
+void st7920_fb_fill(uint8_t pattern);
+
+/**
+ * Set or clear a pixel, ignored outside the band.
+ * @param x Column (0-127)
+ * @param y Display row (0-63)
+ * @param on Non zero to set the pixel
+ */
+void st7920_fb_pixel(uint8_t x, uint8_t y, uint8_t on);
+
+/**
+ * Write one 16 pixel GDRAM word, ignored outside the band.
+ * @param x Word in X direction (0-7)
+ * @param y Display row (0-63)
+ * @param w Pixels, MSB is leftmost
+ */
+void st7920_fb_word(uint8_t x, uint8_t y, uint16_t w);
+
+/**
+ * Copy the rows of the band from a full 128x64 bitmap (16 bytes per row, MSB leftmost).
+ * @param bitmap ST7920_FB_HEIGHT * ST7920_FB_STRIDE bytes
+ */
+void st7920_fb_blit(const uint8_t *bitmap);
+
+/**
+ * Send the changed words of the band to the GDRAM, consecutive words of a row share one address set.
+ * Requires the extended instruction set (ST7920_EXTENDED_MODE).
+ */
+void st7920_fb_flush(void);
+
+#endif // ST7920_FB_H
@@ -0,0 +1,27 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_fb.c Shadow framebuffer storage.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920_fb.h"
+
+static_assert(ST7920_FB_ROWS >= 1 && ST7920_FB_ROWS <= ST7920_FB_HEIGHT && ST7920_FB_HEIGHT % ST7920_FB_ROWS == 0,
+              "ST7920_FB_ROWS must divide ST7920_FB_HEIGHT");
+static_assert(ST7920_FB_SIZE + ST7920_FB_ROWS <= ST7920_FB_XRAM, "framebuffer band does not fit ST7920_FB_XRAM");
+
+ST7920_FB_MEM uint8_t st7920_fb[ST7920_FB_SIZE];
+ST7920_FB_MEM uint8_t st7920_fb_dirty[ST7920_FB_ROWS];
+uint8_t st7920_fb_top = 0;
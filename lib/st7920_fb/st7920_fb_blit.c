@@ -0,0 +1,36 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_fb_blit.c Copy a full screen bitmap into the framebuffer.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920_fb.h"
+
+void st7920_fb_blit(const uint8_t *bitmap) {
+  ST7920_FB_MEM uint8_t *p = st7920_fb;
+  bitmap += st7920_fb_top * ST7920_FB_STRIDE;
+  for(uint8_t y = 0; y < ST7920_FB_ROWS; y++) {
+    uint8_t dirty = 0;
+    for(uint8_t b = 0; b < ST7920_FB_STRIDE; b++) {
+      if(*p != *bitmap) {
+        *p = *bitmap;
+        dirty |= 1 << (b >> 1);
+      }
+      p++;
+      bitmap++;
+    }
+    st7920_fb_dirty[y] |= dirty;
+  }
+}
@@ -0,0 +1,52 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_fb_flush.c Send the changed framebuffer words to the display.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920.h"
+#include "st7920_fb.h"
+
+void st7920_fb_flush(void) {
+  ST7920_FB_MEM uint8_t *row = st7920_fb;
+  for(uint8_t y = 0; y < ST7920_FB_ROWS; y++, row += ST7920_FB_STRIDE) {
+    uint8_t dirty = st7920_fb_dirty[y];
+    if(!dirty)
+      continue;
+    st7920_fb_dirty[y] = 0;
+
+    ST7920_FB_MEM uint8_t *p = row;
+    uint8_t run = 0; // Address counter of the controller points at word x
+    for(uint8_t x = 0; dirty; x++, dirty >>= 1, p += 2) {
+      if(!(dirty & 0x01)) {
+        if(run) {
+          st7920_end();
+          run = 0;
+        }
+        continue;
+      }
+      if(!run) {
+        st7920_pos(x, st7920_fb_top + y);
+        st7920_begin_data();
+        run = 1;
+      }
+      st7920_stream(p[0]); // GDRAM X address increments after each word
+      st7920_stream(p[1]);
+    }
+    if(run) {
+      st7920_end();
+    }
+  }
+}
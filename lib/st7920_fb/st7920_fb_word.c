@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file st7920_fb_word.c Write a 16 pixel framebuffer word.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "st7920_fb.h"
+
+void st7920_fb_word(uint8_t x, uint8_t y, uint16_t w) {
+  y -= st7920_fb_top; // Rows above the band wrap around to large values
+  if(y >= ST7920_FB_ROWS)
+    return;
+  ST7920_FB_MEM uint8_t *p = &st7920_fb[y * ST7920_FB_STRIDE + (x << 1)];
+  if(p[0] != (uint8_t)(w >> 8) || p[1] != (uint8_t)w) {
+    p[0] = w >> 8;
+    p[1] = w;
+    st7920_fb_dirty[y] |= 1 << x;
+  }
+}
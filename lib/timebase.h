@@ -0,0 +1,84 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase.h Drift-free system tick and uptime on the Timer 2 auto reload.
+ * @author Thomas Reidemeister
+ */
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+#include "board.h"
+
+#ifndef TIMEBASE_TICK_US
+#define TIMEBASE_TICK_US 1000 // Tick period, a divisor of 1000
+#endif
+#define TIMEBASE_TICKS_PER_MS (1000 / TIMEBASE_TICK_US)
+#define TIMEBASE_MS(ms) ((ms) * TIMEBASE_TICKS_PER_MS) // Ticks of a period in ms
+
+/*
+ * A tick lasts TIMEBASE_TICK_US * FOSC / (CLOCK_MODE * 1000000) machine cycles. Timer 2 reloads itself from
+ * RCAP2H:RCAP2L in hardware, so the interrupt latency never adds to the period. When the tick is not a whole
+ * number of cycles (e.g. 1843.2 at 22.1184MHz) the handler stretches single periods by one cycle so that the
+ * remainder does not accumulate.
+ */
+#define TIMEBASE_DIVISOR   (CLOCK_MODE * 10000UL)
+#define TIMEBASE_CYCLES    ((uint16_t)(TIMEBASE_TICK_US * (FOSC / 100UL) / TIMEBASE_DIVISOR))
+#define TIMEBASE_REMAINDER (TIMEBASE_TICK_US * (FOSC / 100UL) % TIMEBASE_DIVISOR)
+#define TIMEBASE_RELOAD    ((uint16_t)(0x10000UL - TIMEBASE_CYCLES)) // RCAP2H:RCAP2L
+#define TIMEBASE_US_Q16    (CLOCK_MODE * 15625UL * 16384UL / (FOSC >> 8)) // Microseconds per cycle, 16.16 fixed point
+
+extern volatile uint32_t timebase_ticks; // Ticks since timebase_init(), wraps after 49 days at 1ms
+#if TIMEBASE_REMAINDER
+extern uint16_t timebase_start; // Reload value of the running period
+extern uint16_t timebase_next;  // Reload value of the next period (in RCAP2)
+#endif
+
+/**
+ * Start Timer 2 in 16-bit auto reload mode. The caller enables the interrupt (ET2) and calls timebase_tick()
+ * from its handler (TF2_VECTOR) after clearing TF2. Timer 0 and 1 stay free.
+ */
+void timebase_init(void);
+
+/**
+ * Count a tick, call from the Timer 2 interrupt.
+ */
+void timebase_tick(void);
+
+/**
+ * Time stamp for timebase_since(), consistent also while an overflow waits for its interrupt.
+ * @param tick Output, ticks
+ * @return Machine cycles into the tick
+ */
+uint16_t timebase_clock(uint32_t *tick);
+
+/**
+ * Machine cycles elapsed since a time stamp.
+ * @param tick From timebase_clock()
+ * @param cycles Return value of timebase_clock()
+ * @return Cycles, saturates at 0xFFFF
+ */
+uint16_t timebase_since(uint32_t tick, uint16_t cycles);
+
+/**
+ * Uptime in milliseconds.
+ */
+uint32_t timebase_ms(void);
+
+/**
+ * Uptime in microseconds, wraps after 71 minutes.
+ */
+uint32_t timebase_us(void);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase.c Timebase state.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+static_assert(1000 % TIMEBASE_TICK_US == 0, "TIMEBASE_TICK_US must divide 1000");
+static_assert(FOSC % 100 == 0, "FOSC must be a multiple of 100Hz");
+static_assert(TIMEBASE_CYCLES > 0 && TIMEBASE_TICK_US * (FOSC / 100UL) / TIMEBASE_DIVISOR < 0xFFFF,
+              "TIMEBASE_TICK_US does not fit Timer 2");
+
+volatile uint32_t timebase_ticks = 0;
+#if TIMEBASE_REMAINDER
+uint16_t timebase_start = TIMEBASE_RELOAD;
+uint16_t timebase_next = TIMEBASE_RELOAD;
+#endif
@@ -0,0 +1,43 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_clock.c Time stamp from the tick count and Timer 2.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+uint16_t timebase_clock(uint32_t *tick) {
+  __bit ea = EA;
+  EA = 0;
+  __bit pending = TF2;
+  uint8_t th = TH2;
+  uint8_t tl = TL2;
+  if(TH2 != th || (!pending && TF2)) { // TL2 carried or the timer overflowed between the reads
+    pending = TF2;
+    th = TH2;
+    tl = TL2;
+  }
+  *tick = timebase_ticks;
+#if TIMEBASE_REMAINDER
+  uint16_t start = pending ? timebase_next : timebase_start;
+#else
+  uint16_t start = TIMEBASE_RELOAD;
+#endif
+  if(pending) // The interrupt has not counted the overflow yet
+    (*tick)++;
+  EA = ea;
+  return (((uint16_t)th << 8) | tl) - start;
+}
@@ -0,0 +1,33 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_init.c Start the timebase.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+void timebase_init(void) {
+  T2CON = 0x00;	/* Timer 2 stopped, 16-bit auto reload, no capture, not a baud rate generator */
+  RCAP2H = (uint8_t)(TIMEBASE_RELOAD >> 8);	/* Reload value */
+  RCAP2L = (uint8_t)TIMEBASE_RELOAD;
+  TH2 = (uint8_t)(TIMEBASE_RELOAD >> 8);
+  TL2 = (uint8_t)TIMEBASE_RELOAD;
+#if TIMEBASE_REMAINDER
+  timebase_start = TIMEBASE_RELOAD;
+  timebase_next = TIMEBASE_RELOAD;
+#endif
+  TR2 = 1;	/* Start Timer 2 */
+}
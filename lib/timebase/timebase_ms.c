@@ -0,0 +1,32 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_ms.c Uptime in milliseconds.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+uint32_t timebase_ms(void) {
+  __bit ea = EA;
+  EA = 0; // 32-bit counter shared with the interrupt
+  uint32_t ticks = timebase_ticks;
+  EA = ea;
+#if TIMEBASE_TICKS_PER_MS > 1
+  return ticks / TIMEBASE_TICKS_PER_MS;
+#else
+  return ticks;
+#endif
+}
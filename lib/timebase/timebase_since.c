@@ -0,0 +1,31 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_since.c Cycles since a time stamp.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+uint16_t timebase_since(uint32_t tick, uint16_t cycles) {
+  uint32_t now;
+  uint16_t c = timebase_clock(&now);
+  uint16_t ticks = (uint16_t)now - (uint16_t)tick;
+  if(!ticks)
+    return c - cycles;
+  if(ticks < 0xFFFF / TIMEBASE_CYCLES - 1) // Multiply only across a tick
+    return ticks * TIMEBASE_CYCLES + c - cycles;
+  return 0xFFFF;
+}
@@ -0,0 +1,44 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_tick.c Count a tick.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+#if TIMEBASE_REMAINDER
+static uint32_t timebase_error; // Cycle fraction owed, in 1/TIMEBASE_DIVISOR
+#endif
+
+// Called from the Timer 2 interrupt, keep the 32-bit temporaries out of the overlay segment of the main program
+#pragma save
+#pragma nooverlay
+void timebase_tick(void) {
+  timebase_ticks++;
+#if TIMEBASE_REMAINDER
+  timebase_start = timebase_next; // Loaded by the overflow that raised this interrupt
+  timebase_error += TIMEBASE_REMAINDER;
+  if(timebase_error >= TIMEBASE_DIVISOR) {
+    timebase_error -= TIMEBASE_DIVISOR;
+    timebase_next = TIMEBASE_RELOAD - 1; // One cycle longer
+  } else {
+    timebase_next = TIMEBASE_RELOAD;
+  }
+  RCAP2H = (uint8_t)(timebase_next >> 8); // Next overflow is a full period away
+  RCAP2L = (uint8_t)timebase_next;
+#endif
+}
+#pragma restore
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timebase_us.c Uptime in microseconds.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "timebase.h"
+
+uint32_t timebase_us(void) {
+  uint32_t tick;
+  uint16_t cycles = timebase_clock(&tick);
+#if TIMEBASE_US_Q16 == 0x10000UL
+  return tick * TIMEBASE_TICK_US + cycles; // One cycle per microsecond (12MHz 12T, 6MHz 6T)
+#else
+  return tick * TIMEBASE_TICK_US + (uint16_t)(((uint32_t)cycles * TIMEBASE_US_Q16) >> 16);
+#endif
+}
@@ -0,0 +1,105 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timer.h Timer helpers.
+ * @author Thomas Reidemeister
+ */
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "board.h"
+
+/**
+ * Machine cycles of a timer period in microseconds, rounded to the nearest cycle. Like US_TO_CYCLES() FOSC / 100
+ * keeps 11.0592MHz and 22.1184MHz exact in 32-bit arithmetic.
+ */
+#define TIMER_CYCLES_US(us) (((uint32_t)(us) * (FOSC / 100UL) + CLOCK_MODE * 5000UL) / (CLOCK_MODE * 10000UL))
+
+/**
+ * 16-bit start value for a timer period, the timer overflows after TIMER_CYCLES_US(us) counts.
+ * @param us Period in microseconds, compile time constant (up to 65ms at 12MHz 12T, 35ms at 22.1184MHz)
+ */
+#define TIMER_RELOAD_US(us) ((uint16_t)(0x10000UL - TIMER_CYCLES_US(us)))
+
+// Fails the build when a period does not fit a 16-bit timer at the configured FOSC and CLOCK_MODE
+#define TIMER_ASSERT_US(us) \
+  static_assert(TIMER_CYCLES_US(us) >= 1 && TIMER_CYCLES_US(us) <= 0x10000UL, "timer period out of 16-bit range")
+
+/**
+ * Reload Timer 0 from inside its interrupt handler (16-bit mode has no auto reload).
+ * @param reload 16-bit start value, the timer overflows after 0x10000 - reload counts
+ */
+#define TIMER0_RELOAD(reload) do { \
+    TH0 = (uint8_t)((reload) >> 8); /* Set Timer 0 high byte for 16-bit mode */ \
+    TL0 = (uint8_t)(reload);        /* Set Timer 0 low byte for 16-bit mode */ \
+  } while(0)
+
+/**
+ * Reload Timer 1 from inside its interrupt handler.
+ * @param reload 16-bit start value, the timer overflows after 0x10000 - reload counts
+ */
+#define TIMER1_RELOAD(reload) do { \
+    TH1 = (uint8_t)((reload) >> 8); /* Set Timer 1 high byte for 16-bit mode */ \
+    TL1 = (uint8_t)(reload);        /* Set Timer 1 low byte for 16-bit mode */ \
+  } while(0)
+
+/**
+ * Reload Timer 0 for a period in microseconds (compile time constant) from inside its interrupt handler.
+ */
+#define TIMER0_RELOAD_US(us) do { \
+    TIMER_ASSERT_US(us); \
+    TIMER0_RELOAD(TIMER_RELOAD_US(us)); \
+  } while(0)
+
+/**
+ * Reload Timer 1 for a period in microseconds (compile time constant) from inside its interrupt handler.
+ */
+#define TIMER1_RELOAD_US(us) do { \
+    TIMER_ASSERT_US(us); \
+    TIMER1_RELOAD(TIMER_RELOAD_US(us)); \
+  } while(0)
+
+/**
+ * Start Timer 0 in 16-bit mode, the interrupt is left for the caller to enable (ET0).
+ * @param reload 16-bit start value, TIMER_RELOAD_US() or timer0_init_us() for a period
+ */
+void timer0_init(uint16_t reload);
+
+/**
+ * Start Timer 1 in 16-bit mode, the interrupt is left for the caller to enable (ET1).
+ * @param reload 16-bit start value
+ */
+void timer1_init(uint16_t reload);
+
+/**
+ * Start Timer 0 with a period in microseconds, checked against the 16-bit range at compile time.
+ * @param us Period, compile time constant
+ */
+#define timer0_init_us(us) do { \
+    TIMER_ASSERT_US(us); \
+    timer0_init(TIMER_RELOAD_US(us)); \
+  } while(0)
+
+/**
+ * Start Timer 1 with a period in microseconds, checked against the 16-bit range at compile time.
+ * @param us Period, compile time constant
+ */
+#define timer1_init_us(us) do { \
+    TIMER_ASSERT_US(us); \
+    timer1_init(TIMER_RELOAD_US(us)); \
+  } while(0)
+
+#endif // TIMER_H
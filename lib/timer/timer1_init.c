@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file timer1_init.c Timer 1 setup.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "timer.h"
+
+void timer1_init(uint16_t reload) {
+  TMOD &= 0x0F;	/* Clear Timer 1 mode bits */
+  TMOD |= 0x10;	/* Set Timer 1 mode to 16-bit */
+  TIMER1_RELOAD(reload);
+  TF1 = 0;	/* Clear Timer 1 overflow flag */
+  TR1 = 1;	/* Start Timer 1 */
+}
@@ -0,0 +1,109 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart.h Interrupt driven serial transmitter with CSV and binary framing.
+ * @author Thomas Reidemeister
+ */
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+#include "board.h"
+
+// Overridden from meson.build (uart_baud)
+#ifndef UART_BAUD
+#define UART_BAUD 4800 // 12MHz/12T reaches 4800 within 0.2%, 9600 and up need a baud rate crystal (11.0592MHz)
+#endif
+
+#define UART_BAUD_TOLERANCE 20 // Largest rate error in permille accepted at compile time
+
+/*
+ * Timer 1 in 8-bit auto reload with SMOD=1 counts FOSC/(16*CLOCK_MODE), Timer 2 in baud rate mode counts
+ * FOSC*12/(32*CLOCK_MODE). The dividers are rounded to the nearest count.
+ */
+#define UART_T1_CLOCK (FOSC / (16UL * CLOCK_MODE))
+#define UART_T2_CLOCK (FOSC * 12UL / (32UL * CLOCK_MODE))
+#define UART_DIVIDER(clock, baud) (((clock) + (baud) / 2) / (baud))
+#define UART_ERROR(clock, baud) /* Permille, absolute */ \
+  ((clock) / UART_DIVIDER(clock, baud) > (baud) ? \
+   ((clock) / UART_DIVIDER(clock, baud) - (baud)) * 1000UL / (baud) : \
+   ((baud) - (clock) / UART_DIVIDER(clock, baud)) * 1000UL / (baud))
+
+#define UART_T1_RELOAD (256 - UART_DIVIDER(UART_T1_CLOCK, UART_BAUD))    // TH1
+#define UART_T2_RELOAD (65536 - UART_DIVIDER(UART_T2_CLOCK, UART_BAUD))  // RCAP2H:RCAP2L
+
+// Transmit ring buffer, power of two up to 128 bytes
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 64
+#endif
+#define UART_TX_MASK (UART_TX_SIZE - 1)
+
+#ifndef UART_MEM
+#define UART_MEM __xdata
+#endif
+
+#define UART_LINE_SIZE 32 // Longest CSV line including "\r\n"
+#define UART_FRAME_MAX 16 // Longest binary frame payload
+#define UART_SYNC      0xA5 // First byte of a binary frame
+
+extern UART_MEM uint8_t uart_tx_buf[UART_TX_SIZE];
+extern volatile uint8_t uart_tx_head; // Next byte to queue, written by uart_write() only
+extern volatile uint8_t uart_tx_tail; // Next byte to send, written by uart_tx_next() only
+extern volatile __bit uart_tx_idle;   // Nothing on the line, the next uart_write() kicks the interrupt
+extern uint8_t uart_dropped;          // Writes refused for lack of space
+
+/**
+ * 8N1 at UART_BAUD with Timer 1 as baud rate generator (8-bit auto reload, SMOD=1), receiver off.
+ * The caller enables the serial interrupt (ES) and calls uart_tx_next() from it, Timer 1 is taken.
+ */
+void uart_init(void);
+
+/**
+ * As uart_init(), but with Timer 2 as baud rate generator (8052), leaving Timer 1 free.
+ */
+void uart_init_timer2(void);
+
+/**
+ * Send the next queued byte, call from the application's serial interrupt handler (SI0_VECTOR).
+ */
+void uart_tx_next(void);
+
+/**
+ * Queue bytes for sending without waiting. Either all bytes are queued or none.
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return 1 if queued, 0 if the ring buffer lacks space (counted in uart_dropped)
+ */
+uint8_t uart_write(const uint8_t *data, uint8_t len);
+
+/**
+ * Queue one CSV line "tag,field,...\r\n", numbers in decimal.
+ * @param tag Record name, e.g. "t"
+ * @param fields Values
+ * @param count Number of values
+ * @return 1 if queued, 0 if the line is longer than UART_LINE_SIZE or does not fit into the ring buffer
+ */
+uint8_t uart_csv(const char *tag, const int16_t *fields, uint8_t count);
+
+/**
+ * Queue a binary frame: UART_SYNC, type, length, payload, CRC-8 (Dallas/Maxim, see wire_crc8()) over
+ * type, length and payload.
+ * @param type Record type
+ * @param payload Bytes
+ * @param len 0-UART_FRAME_MAX
+ * @return 1 if queued, 0 if too long or the ring buffer lacks space
+ */
+uint8_t uart_frame(uint8_t type, const uint8_t *payload, uint8_t len);
+
+#endif // UART_H
@@ -0,0 +1,28 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart.c Transmit ring buffer.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+static_assert((UART_TX_SIZE & UART_TX_MASK) == 0 && UART_TX_SIZE <= 128, "UART_TX_SIZE must be a power of two <= 128");
+
+UART_MEM uint8_t uart_tx_buf[UART_TX_SIZE];
+volatile uint8_t uart_tx_head = 0;
+volatile uint8_t uart_tx_tail = 0;
+volatile __bit uart_tx_idle = 1;
+uint8_t uart_dropped = 0;
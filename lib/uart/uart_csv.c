@@ -0,0 +1,55 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_csv.c Queue a CSV line.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "bcd.h"
+#include "uart.h"
+
+static UART_MEM uint8_t uart_line[UART_LINE_SIZE];
+
+uint8_t uart_csv(const char *tag, const int16_t *fields, uint8_t count) {
+  uint8_t len = 0;
+  while(*tag && len < UART_LINE_SIZE) {
+    uart_line[len++] = *tag++;
+  }
+  while(count--) {
+    uint8_t bcd[BCD_U16_DIGITS];
+    int16_t v = *fields++;
+    uint8_t digits = BCD_U16_DIGITS;
+    bcd_u16(v < 0 ? 0 - (uint16_t)v : (uint16_t)v, bcd);
+    while(digits > 1 && !bcd[digits - 1])
+      digits--;
+    if(len + 1 + (v < 0) + digits + 2 > UART_LINE_SIZE) {
+      uart_dropped++;
+      return 0;
+    }
+    uart_line[len++] = ',';
+    if(v < 0)
+      uart_line[len++] = '-';
+    while(digits--) {
+      uart_line[len++] = '0' + bcd[digits];
+    }
+  }
+  if(len + 2 > UART_LINE_SIZE) {
+    uart_dropped++;
+    return 0;
+  }
+  uart_line[len++] = '\r';
+  uart_line[len++] = '\n';
+  return uart_write(uart_line, len);
+}
@@ -0,0 +1,38 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_frame.c Queue a binary frame.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "uart.h"
+#include "wire.h"
+
+static UART_MEM uint8_t uart_frame_buf[UART_FRAME_MAX + 4];
+
+uint8_t uart_frame(uint8_t type, const uint8_t *payload, uint8_t len) {
+  if(len > UART_FRAME_MAX) {
+    uart_dropped++;
+    return 0;
+  }
+  uart_frame_buf[0] = UART_SYNC;
+  uart_frame_buf[1] = type;
+  uart_frame_buf[2] = len;
+  for(uint8_t i = 0; i < len; i++) {
+    uart_frame_buf[3 + i] = payload[i];
+  }
+  uart_frame_buf[3 + len] = wire_crc8(uart_frame_buf + 1, len + 2);
+  return uart_write(uart_frame_buf, len + 4);
+}
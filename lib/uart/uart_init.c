@@ -0,0 +1,37 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_init.c Serial port with Timer 1 as baud rate generator.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+static_assert(UART_DIVIDER(UART_T1_CLOCK, UART_BAUD) >= 1 && UART_DIVIDER(UART_T1_CLOCK, UART_BAUD) <= 256,
+              "UART_BAUD out of the Timer 1 range");
+static_assert(UART_ERROR(UART_T1_CLOCK, UART_BAUD) <= UART_BAUD_TOLERANCE,
+              "UART_BAUD not reachable with Timer 1 at this FOSC, use uart_init_timer2() or another crystal");
+
+void uart_init(void) {
+  TR1 = 0;	/* Stop Timer 1 */
+  TMOD &= 0x0F;	/* Clear Timer 1 mode bits */
+  TMOD |= 0x20;	/* Set Timer 1 mode to 8-bit auto reload */
+  TH1 = UART_T1_RELOAD;	/* Reload value */
+  TL1 = UART_T1_RELOAD;
+  PCON |= SMOD;	/* Double the baud rate */
+  SCON = 0x40;	/* Mode 1: 8N1, variable rate, receiver off */
+  uart_tx_idle = 1;
+  TR1 = 1;	/* Start Timer 1 */
+}
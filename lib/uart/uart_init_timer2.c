@@ -0,0 +1,35 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_init_timer2.c Serial port with Timer 2 as baud rate generator.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8052.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+static_assert(UART_DIVIDER(UART_T2_CLOCK, UART_BAUD) >= 1, "UART_BAUD out of the Timer 2 range");
+static_assert(UART_ERROR(UART_T2_CLOCK, UART_BAUD) <= UART_BAUD_TOLERANCE,
+              "UART_BAUD not reachable with Timer 2 at this FOSC, use another crystal");
+
+void uart_init_timer2(void) {
+  T2CON = 0x30;	/* Timer 2 stopped, RCLK and TCLK: baud rate generator for both directions */
+  RCAP2H = (uint8_t)(UART_T2_RELOAD >> 8);	/* Reload value */
+  RCAP2L = (uint8_t)UART_T2_RELOAD;
+  TH2 = (uint8_t)(UART_T2_RELOAD >> 8);
+  TL2 = (uint8_t)UART_T2_RELOAD;
+  SCON = 0x40;	/* Mode 1: 8N1, variable rate, receiver off */
+  uart_tx_idle = 1;
+  TR2 = 1;	/* Start Timer 2 */
+}
@@ -0,0 +1,36 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_tx_next.c Serial interrupt work.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+// Called from the serial interrupt, keep any compiler temporaries out of the overlay segment of the main program
+#pragma save
+#pragma nooverlay
+void uart_tx_next(void) {
+  if(!TI)
+    return;
+  TI = 0;
+  if(uart_tx_tail != uart_tx_head) {
+    SBUF = uart_tx_buf[uart_tx_tail & UART_TX_MASK];
+    uart_tx_tail++;
+  } else {
+    uart_tx_idle = 1; // The next uart_write() restarts the interrupt
+  }
+}
+#pragma restore
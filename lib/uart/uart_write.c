@@ -0,0 +1,38 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file uart_write.c Queue bytes for the serial interrupt.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+uint8_t uart_write(const uint8_t *data, uint8_t len) {
+  uint8_t head = uart_tx_head;
+  if((uint8_t)(UART_TX_SIZE - (uint8_t)(head - uart_tx_tail)) < len) {
+    uart_dropped++;
+    return 0;
+  }
+  while(len--) {
+    uart_tx_buf[head & UART_TX_MASK] = *data++;
+    head++;
+  }
+  uart_tx_head = head; // Publish before looking at the idle flag, the interrupt then sees the new bytes
+  if(uart_tx_idle) { // Only set while no transmission is pending, so the interrupt cannot race this
+    uart_tx_idle = 0;
+    TI = 1; // Raise the serial interrupt, it sends the first byte
+  }
+  return 1;
+}
@@ -0,0 +1,88 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire.h Bit-banged 1-Wire bus master.
+ * @author Thomas Reidemeister
+ */
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <stdint.h>
+
+#define DS18B20_DQ P3_7 // 1 wire data pin for DS18B20
+
+#define WIRE_ROM_SIZE    8    // Family code, 48-bit serial number, CRC
+#define WIRE_SEARCH_ROM  0xF0
+#define WIRE_MATCH_ROM   0x55
+#define WIRE_SKIP_ROM    0xCC
+
+/*
+ * Every time slot masks interrupts only for its time critical part (at most the 61us of a write slot or
+ * the presence detection after a reset), so a display multiplexed from a timer interrupt keeps running
+ * during a transaction.
+ */
+
+/**
+ * Reset pulse and wait for the presence pulse.
+ * @return 1 if at least one device answered, 0 if the bus stayed high (no device, broken wire)
+ */
+uint8_t wire_init(void);
+
+/**
+ * Write a byte LSB first.
+ * @param byte Byte to write
+ */
+void wire_write_byte(uint8_t byte);
+
+/**
+ * Read a byte LSB first.
+ * @return Byte read
+ */
+uint8_t wire_read_byte(void);
+
+/**
+ * Write a single bit (one time slot).
+ * @param bit Bit to write (0 or 1)
+ */
+void wire_write_bit(uint8_t bit);
+
+/**
+ * Read a single bit (one time slot).
+ * @return Bit read
+ */
+uint8_t wire_read_bit(void);
+
+/**
+ * Address the devices for the next function command, call after wire_init().
+ * @param rom ROM of the device (Match ROM), 0 for all devices (Skip ROM)
+ */
+void wire_select(const uint8_t *rom);
+
+/**
+ * Find the next device with the ROM Search algorithm (Maxim AN187).
+ * Start with *last_discrepancy = 0, the search is complete when it is 0 again after a successful call.
+ * @param rom ROM found last time (input) and next ROM (output), WIRE_ROM_SIZE bytes
+ * @param last_discrepancy Search state between calls
+ * @return 1 if a device with a valid CRC was found, 0 on no presence, bus errors or CRC mismatch
+ */
+uint8_t wire_search(uint8_t *rom, uint8_t *last_discrepancy);
+
+/**
+ * Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1) as used for the ROM and scratchpad.
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return CRC, 0 when the buffer ends with its own valid CRC
+ */
+uint8_t wire_crc8(const uint8_t *data, uint8_t len);
+
+#endif // WIRE_H
@@ -0,0 +1,35 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_crc8.c Dallas/Maxim CRC8.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "wire.h"
+
+uint8_t wire_crc8(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+  while(len--) {
+    uint8_t byte = *data++;
+    for(uint8_t i = 0; i < 8; i++) { // LSB first, reflected polynomial 0x8C
+      uint8_t mix = (crc ^ byte) & 0x01;
+      crc >>= 1;
+      if(mix) {
+        crc ^= 0x8C;
+      }
+      byte >>= 1;
+    }
+  }
+  return crc;
+}
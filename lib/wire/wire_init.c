@@ -0,0 +1,38 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_init.c 1-Wire reset and presence detect.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "wire.h"
+
+uint8_t wire_init(void) { // https://www.analog.com/media/en/technical-documentation/data-sheets/ds18b20.pdf p 15
+  DS18B20_DQ = 0;   // Assert reset pulse (may be stretched by interrupts)
+  delay_us(480);
+  __bit ea = EA;
+  EA = 0;            // The presence pulse can be as short as 60us
+  DS18B20_DQ = 1;
+  delay_us(15);      // Device waits 15-60us before answering
+  uint8_t presence = 0;
+  for(uint8_t i = 0; i < 24 && !presence; i++) { // Presence pulse starts within 60us, lasts 60-240us
+    presence = !DS18B20_DQ;
+    delay_us(10);
+  }
+  EA = ea;
+  delay_us(480);     // Presence pulse and recovery
+  return presence;
+}
@@ -0,0 +1,34 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_read_bit.c Read a single 1-Wire time slot.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "wire.h"
+
+uint8_t wire_read_bit(void) {
+  __bit ea = EA;
+  EA = 0; // Slot start to sampling point only, the recovery may be interrupted
+  DS18B20_DQ = 0; // Start time slot
+  delay_us(1);
+  DS18B20_DQ = 1; // Release bus
+  delay_us(8); // Sample within 15us of the slot start
+  uint8_t bit = DS18B20_DQ;
+  EA = ea;
+  delay_us(45); // Slot lasts at least 60us
+  return bit;
+}
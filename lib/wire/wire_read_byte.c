@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_read_byte.c 1-Wire byte read.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "wire.h"
+
+uint8_t wire_read_byte(void) {
+  uint8_t byte = 0;
+
+  for(uint8_t i = 0; i < 8; i++) {
+    byte >>= 1;
+    if(wire_read_bit())
+      byte |= 0x80;
+  }
+  return byte;
+}
@@ -0,0 +1,55 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_search.c 1-Wire ROM Search.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "wire.h"
+
+uint8_t wire_search(uint8_t *rom, uint8_t *last_discrepancy) {
+  if(!wire_init()) {
+    *last_discrepancy = 0;
+    return 0;
+  }
+  wire_write_byte(WIRE_SEARCH_ROM);
+
+  uint8_t last_zero = 0; // Last bit where both values were present and 0 was taken
+  for(uint8_t bit = 1; bit <= WIRE_ROM_SIZE * 8; bit++) {
+    uint8_t *byte = &rom[(bit - 1) >> 3];
+    uint8_t mask = 1 << ((bit - 1) & 0x07);
+    uint8_t id = wire_read_bit();  // Wired AND of the bit of all remaining devices
+    uint8_t cmp = wire_read_bit(); // and of its complement
+    uint8_t dir;
+    if(id && cmp) { // No device left
+      *last_discrepancy = 0;
+      return 0;
+    } else if(id != cmp) { // All remaining devices agree
+      dir = id;
+    } else { // Discrepancy: repeat the previous path before the last one, take 1 at it, 0 after it
+      dir = bit < *last_discrepancy ? (*byte & mask) != 0 : bit == *last_discrepancy;
+      if(!dir) {
+        last_zero = bit;
+      }
+    }
+    if(dir) {
+      *byte |= mask;
+    } else {
+      *byte &= ~mask;
+    }
+    wire_write_bit(dir); // Devices with the other value drop out
+  }
+  *last_discrepancy = last_zero;
+  return wire_crc8(rom, WIRE_ROM_SIZE) == 0;
+}
@@ -0,0 +1,30 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_select.c Address 1-Wire devices with Match ROM or Skip ROM.
+ * @author Thomas Reidemeister
+ */
+#include <stdint.h>
+
+#include "wire.h"
+
+void wire_select(const uint8_t *rom) {
+  if(!rom) {
+    wire_write_byte(WIRE_SKIP_ROM);
+    return;
+  }
+  wire_write_byte(WIRE_MATCH_ROM);
+  for(uint8_t i = 0; i < WIRE_ROM_SIZE; i++) {
+    wire_write_byte(rom[i]);
+  }
+}
@@ -0,0 +1,32 @@
+/**
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file wire_write_bit.c Write a single 1-Wire time slot.
+ * @author Thomas Reidemeister
+ */
+#include <mcs51/8051.h>
+#include <stdint.h>
+
+#include "delay.h"
+#include "wire.h"
+
+void wire_write_bit(uint8_t bit) {
+  __bit ea = EA;
+  EA = 0; // An interrupt inside the slot would stretch a 0 past 120us or turn a 1 into a 0
+  DS18B20_DQ = 0; // Start time slot
+  delay_us(1);
+  DS18B20_DQ = bit;  // Release within 15us for a 1
+  delay_us(60); // Slot lasts at least 60us
+  DS18B20_DQ = 1; // Finish time slot
+  EA = ea;
+}
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# @file bench.py Cycle benchmark of a firmware image in the ucsim (s51) simulator.
+# @author Thomas Reidemeister
+#
+# The image is loaded into s51 and breakpoints are placed on
+#  * the entry of every function given with --func and on every ret/reti
+#    instruction of the image, a call is closed by the first ret/reti that
+#    executes with the stack pointer seen at entry (handles tail jumps), and
+#  * every BENCH_BEGIN()/BENCH_END() marker found in the linker map (see
+#    lib/bench.h).
+# The clock counter reported by the simulator is sampled at every stop and the
+# per function/region cycle counts are written as JSON. With --expect the run
+# fails when a function or region took more or fewer cycles than given.
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+# Instruction length of every 8051 opcode (used to locate ret/reti)
+OPCODE_LENGTH = [
+  # x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+    1, 2, 3, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 0x
+    3, 2, 3, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 1x
+    3, 2, 1, 1, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 2x
+    3, 2, 1, 1, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 3x
+    2, 2, 2, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 4x
+    2, 2, 2, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 5x
+    2, 2, 2, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 6x
+    2, 2, 2, 1, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, # 7x
+    2, 2, 2, 1, 1, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, # 8x
+    3, 2, 2, 1, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # 9x
+    2, 2, 2, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, # Ax
+    2, 2, 2, 1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, # Bx
+    2, 2, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # Cx
+    2, 2, 2, 1, 1, 3, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, # Dx
+    1, 2, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # Ex
+    1, 2, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, # Fx
+]
+OP_RET = 0x22
+OP_RETI = 0x32
+RET_CYCLES = 2 # ret/reti, not yet executed when stopped
+
+MARKER = re.compile(r'^_bench_(\w+)_(begin|end)$')
+
+
+def parse_map(path):
+  """Return ({symbol: address}, [(start, end)]) of the code symbols and code areas in an aslink map."""
+  symbols = {}
+  areas = []
+  area_re = re.compile(r'^(\S+)\s+([0-9A-Fa-f]+)\s+([0-9A-Fa-f]+)\s+=\s+\d+\.\s+bytes\s+\(([^)]*)\)')
+  sym_re = re.compile(r'^\s*C:\s+([0-9A-Fa-f]+)\s+(\S+)')
+  with open(path) as f:
+    for line in f:
+      m = area_re.match(line)
+      if m:
+        start, size = int(m.group(2), 16), int(m.group(3), 16)
+        if 'CODE' in m.group(4) and size > 0:
+          areas.append((start, start + size))
+        continue
+      m = sym_re.match(line)
+      if m:
+        symbols[m.group(2)] = int(m.group(1), 16)
+  return symbols, areas
+
+
+def read_ihx(path):
+  """Load an Intel HEX image into a 64 KiB code space."""
+  code = bytearray(0x10000)
+  with open(path) as f:
+    for line in f:
+      line = line.strip()
+      if not line.startswith(':'):
+        continue
+      count, addr, rtype = int(line[1:3], 16), int(line[3:7], 16), int(line[7:9], 16)
+      if rtype == 0x00:
+        code[addr:addr + count] = bytes.fromhex(line[9:9 + 2 * count])
+  return code
+
+
+def find_returns(code, symbols, areas):
+  """Linear sweep over every code symbol, collecting the addresses of ret/reti."""
+  starts = sorted(set(a for n, a in symbols.items() if not MARKER.match(n)))
+  rets = set()
+  for start, end in areas:
+    entries = [a for a in starts if start <= a < end]
+    for i, pc in enumerate(entries):
+      stop = entries[i + 1] if i + 1 < len(entries) else end
+      while pc < stop:
+        if code[pc] in (OP_RET, OP_RETI):
+          rets.add(pc)
+        pc += OPCODE_LENGTH[code[pc]]
+  return rets
+
+
+def simulate(args, breakpoints):
+  """Run the image in s51 and return [(pc, sp, clocks, isr_clocks)] for every breakpoint stop."""
+  script = ['break 0x%04x' % a for a in sorted(breakpoints)]
+  script += ['run', 'state', 'info registers'] * args.max_stops
+  script += ['quit']
+  cmd = [args.sim, '-t', args.cpu, '-X', str(args.xtal), args.image]
+  try:
+    proc = subprocess.run(cmd, input='\n'.join(script) + '\n', capture_output=True,
+                          text=True, timeout=args.timeout)
+    output = proc.stdout
+  except subprocess.TimeoutExpired as e: # Image stopped hitting breakpoints (e.g. waits on a pin)
+    output = e.stdout.decode(errors='replace') if isinstance(e.stdout, bytes) else (e.stdout or '')
+
+  stops = []
+  for chunk in re.split(r'Stop at ', output)[1:]:
+    pc = re.match(r'(?:0x)?([0-9A-Fa-f]+)', chunk)
+    clocks = re.search(r'Total time[^\n]*\((\d+)\s+(?:clks|clocks|ticks)\)', chunk)
+    isr = re.search(r'Time in isr[^\n]*\((\d+)\s+(?:clks|clocks|ticks)\)', chunk)
+    sp = re.search(r'\bSP\b\s*=?\s*0x([0-9A-Fa-f]+)', chunk)
+    if not (pc and clocks and sp):
+      break # Simulator killed mid-command
+    stops.append((int(pc.group(1), 16), int(sp.group(1), 16), int(clocks.group(1)),
+                  int(isr.group(1)) if isr else 0))
+  return stops
+
+
+def summarize(samples, clocks_per_cycle):
+  cycles = [s[0] // clocks_per_cycle for s in samples]
+  with_isr = [s[1] // clocks_per_cycle for s in samples]
+  return {
+    'calls': len(samples),
+    'min_cycles': min(cycles),
+    'max_cycles': max(cycles),
+    'avg_cycles': round(sum(cycles) / len(cycles), 1),
+    'max_cycles_with_isr': max(with_isr),
+  }
+
+
+def main():
+  parser = argparse.ArgumentParser(description='Cycle benchmark of a firmware image in s51')
+  parser.add_argument('image', help='Intel HEX image, the linker map is expected next to it')
+  parser.add_argument('--sim', default='s51', help='ucsim 8051 simulator binary')
+  parser.add_argument('--cpu', default='8052', help='simulated CPU type')
+  parser.add_argument('--xtal', type=int, default=12000000, help='crystal frequency in Hz')
+  parser.add_argument('--clocks-per-cycle', type=int, default=12, help='12 for 12T, 6 for 6T mode')
+  parser.add_argument('--func', action='append', default=[], help='function to measure (C name)')
+  parser.add_argument('--max-stops', type=int, default=5000, help='breakpoint hits to record')
+  parser.add_argument('--timeout', type=float, default=60, help='simulator wall time limit in s')
+  parser.add_argument('--name', help='program name in the report')
+  parser.add_argument('--out', help='JSON report (default: stdout)')
+  parser.add_argument('--expect', action='append', default=[], metavar='NAME=MIN:MAX',
+                      help='fail unless every call of function or region NAME took MIN..MAX cycles (without ISRs)')
+  args = parser.parse_args()
+
+  symbols, areas = parse_map(os.path.splitext(args.image)[0] + '.map')
+  code = read_ihx(args.image)
+
+  entries = {}
+  for f in args.func:
+    if '_' + f not in symbols:
+      sys.exit('bench: function %s not found in map (static functions are not visible)' % f)
+    entries[symbols['_' + f]] = f
+  markers = {} # address -> [(name, kind)], an end and the next begin may share an address
+  for n, a in symbols.items():
+    m = MARKER.match(n)
+    if m:
+      markers.setdefault(a, []).append((m.group(1), m.group(2)))
+  for found in markers.values():
+    found.sort(key=lambda k: k[1] != 'end') # Close a region before opening the next
+  rets = find_returns(code, symbols, areas) if entries else set()
+
+  stops = simulate(args, set(entries) | set(markers) | rets)
+  if not stops:
+    sys.exit('bench: no breakpoint was hit, check the simulator output')
+
+  frames = [] # Open calls (name, sp, clocks, isr_clocks)
+  regions = {} # Open regions name -> (clocks, isr_clocks)
+  funcs = {f: [] for f in args.func}
+  marks = {}
+  for pc, sp, clocks, isr in stops:
+    if pc in entries:
+      frames.append((entries[pc], sp, clocks, isr))
+    if pc in rets:
+      for i in range(len(frames) - 1, -1, -1):
+        if frames[i][1] == sp:
+          name, _, c0, i0 = frames[i]
+          total = clocks - c0 + RET_CYCLES * args.clocks_per_cycle
+          funcs[name].append((total - (isr - i0), total))
+          del frames[i:] # Frames above never returned normally
+          break
+    for name, kind in markers.get(pc, []):
+      if kind == 'begin':
+        regions[name] = (clocks, isr)
+      elif name in regions:
+        c0, i0 = regions.pop(name)
+        marks.setdefault(name, []).append((clocks - c0 - (isr - i0), clocks - c0))
+
+  report = {
+    'program': args.name or os.path.basename(os.path.splitext(args.image)[0]),
+    'xtal_hz': args.xtal,
+    'clocks_per_cycle': args.clocks_per_cycle,
+    'simulated_cycles': stops[-1][2] // args.clocks_per_cycle,
+    'functions': {n: summarize(s, args.clocks_per_cycle) for n, s in funcs.items() if s},
+    'regions': {n: summarize(s, args.clocks_per_cycle) for n, s in marks.items()},
+  }
+  text = json.dumps(report, indent=2) + '\n'
+  if args.out:
+    with open(args.out, 'w') as f:
+      f.write(text)
+  sys.stdout.write(text)
+
+  failed = 0
+  for e in args.expect:
+    name, limits = e.split('=')
+    lo, hi = (int(x) for x in limits.split(':'))
+    r = report['functions'].get(name) or report['regions'].get(name)
+    if not r:
+      sys.stderr.write('bench: %s was not measured\n' % name)
+      failed += 1
+    elif r['min_cycles'] < lo or r['max_cycles'] > hi:
+      sys.stderr.write('bench: %s took %d..%d cycles, expected %d..%d\n' % (name, r['min_cycles'], r['max_cycles'],
+                                                                          lo, hi))
+      failed += 1
+  if failed:
+    sys.exit(1)
+
+
+if __name__ == '__main__':
+  main()